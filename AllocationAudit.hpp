@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "Base.hpp"
+#include <cstddef>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * diagnostic mode that checks the handler event paths never allocate.
+ * only active when built with DGL_ALLOCATION_AUDIT defined, which replaces the global operator new and delete.
+ * DGL_AUDIT_ALLOCATIONS marks a function as allocation free until it returns, any allocation on the same thread
+ * in the meantime is a violation, reported with the innermost marked call site.
+ * DGL_AUDIT_SUSPEND lifts it again for the rest of the block, around calls out of the handlers.
+ * without the define the macro expands to nothing and nothing is hooked.
+*/
+class AllocationAudit
+{
+public:
+    enum Mode
+    {
+        // print every violation to stderr and carry on
+        kModeReport,
+        // print the first violation and abort, for test runs
+        kModeAbort
+    };
+
+    struct Violation
+    {
+        const char *site;
+        const char *file;
+        int line;
+        std::size_t size;
+    };
+
+    class Scope
+    {
+    public:
+        Scope(const char *site, const char *file, int line) noexcept;
+        ~Scope() noexcept;
+
+    private:
+        const char *const site;
+        const char *const file;
+        const int line;
+        Scope *const previous;
+
+        friend class AllocationAudit;
+
+        DISTRHO_DECLARE_NON_COPYABLE(Scope)
+    };
+
+    /*
+     * lifts the audit until destroyed, around calls out of the handlers into code they do not own:
+     * user callbacks, the parameter queue and the repaint scheduler
+    */
+    class Suspend
+    {
+    public:
+        Suspend() noexcept;
+        ~Suspend() noexcept;
+
+    private:
+        Scope *const suspended;
+
+        DISTRHO_DECLARE_NON_COPYABLE(Suspend)
+    };
+
+    /*
+     * false when built without DGL_ALLOCATION_AUDIT
+    */
+    static bool isEnabled() noexcept;
+
+    static void setMode(Mode mode) noexcept;
+    static uint getNumViolations() noexcept;
+    static bool getLastViolation(Violation &violation) noexcept;
+    static void reset() noexcept;
+
+    /*
+     * called by the replaced operator new
+    */
+    static void checkAllocation(std::size_t size) noexcept;
+};
+
+#ifdef DGL_ALLOCATION_AUDIT
+# define DGL_AUDIT_ALLOCATIONS(site) AllocationAudit::Scope allocationAuditScope(site, __FILE__, __LINE__)
+# define DGL_AUDIT_SUSPEND() AllocationAudit::Suspend allocationAuditSuspend
+#else
+# define DGL_AUDIT_ALLOCATIONS(site)
+# define DGL_AUDIT_SUSPEND()
+#endif
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "SubWidget.hpp"
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * records the mouse, motion and scroll events reaching the Nano* widgets into a compact binary file,
+ * which EventReplayer can feed back into the same widgets.
+ * widgets are identified by the order they are added in, so add them in the same order when replaying.
+ * one recorder can be active at a time, UI thread only. while none is, recording costs a single pointer check.
+*/
+class EventRecorder
+{
+public:
+    EventRecorder();
+
+    /*
+     * stops recording
+    */
+    ~EventRecorder();
+
+    /*
+     * returns the id of the widget, events of widgets that were not added are not recorded
+    */
+    uint addWidget(SubWidget *widget);
+
+    bool start(const char *filename);
+    void stop();
+    bool isRecording() const noexcept;
+    uint getNumEvents() const noexcept;
+
+    /*
+     * called by the Nano* widgets for every event they receive
+    */
+    static void recordMouse(const SubWidget *const widget, const Widget::MouseEvent &ev)
+    {
+        if (current != nullptr)
+            current->writeMouse(widget, ev);
+    }
+
+    static void recordMotion(const SubWidget *const widget, const Widget::MotionEvent &ev)
+    {
+        if (current != nullptr)
+            current->writeMotion(widget, ev);
+    }
+
+    static void recordScroll(const SubWidget *const widget, const Widget::ScrollEvent &ev)
+    {
+        if (current != nullptr)
+            current->writeScroll(widget, ev);
+    }
+
+private:
+    struct WidgetId
+    {
+        const SubWidget *widget;
+        uint id;
+
+        bool operator<(const SubWidget *const other) const noexcept
+        {
+            return std::less<const SubWidget *>()(widget, other);
+        }
+    };
+
+    // sorted by widget, so each recorded event finds its id with a binary search
+    std::vector<WidgetId> widgetIds;
+    std::vector<uint8_t> buffer;
+    FILE *file;
+    uint numEvents;
+
+    static EventRecorder *current;
+
+    int findWidget(const SubWidget *widget) const noexcept;
+    uint8_t *prepare(const SubWidget *widget, uint8_t type, const Widget::BaseEvent &ev, size_t size);
+    void writeMouse(const SubWidget *widget, const Widget::MouseEvent &ev);
+    void writeMotion(const SubWidget *widget, const Widget::MotionEvent &ev);
+    void writeScroll(const SubWidget *widget, const Widget::ScrollEvent &ev);
+    void flush();
+
+    DISTRHO_DECLARE_NON_COPYABLE(EventRecorder)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * feeds a recorded file back into the same widgets in place of the user, by calling their event functions.
+ * the widgets still need their window, only the input is replaced.
+ * kTimingFullSpeed delivers the events back to back, for measuring event handling time,
+ * kTimingOriginal waits between events as long as the user did.
+*/
+class EventReplayer
+{
+public:
+    enum Timing
+    {
+        kTimingFullSpeed,
+        kTimingOriginal
+    };
+
+    EventReplayer();
+
+    uint addWidget(SubWidget *widget);
+
+    /*
+     * reads and validates the whole file, returns false if it is not a recording or refers to
+     * widgets that were not added
+    */
+    bool load(const char *filename);
+    uint getNumEvents() const noexcept;
+
+    /*
+     * returns the number of events the widgets consumed
+    */
+    uint replay(Timing timing = kTimingFullSpeed);
+
+    /*
+     * seconds spent inside the widgets' event functions during the last replay
+    */
+    double getLastReplayTime() const noexcept;
+
+private:
+    std::vector<SubWidget *> widgets;
+    std::vector<uint8_t> data;
+    uint numEvents;
+    double lastReplayTime;
+
+    DISTRHO_DECLARE_NON_COPYABLE(EventReplayer)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "Base.hpp"
+#include <cstdint>
+#include <cstdio>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * event path instrumentation for the handlers in ExtraEventHandlers.
+ * only active when built with DGL_EVENT_TRACE defined. otherwise DGL_TRACE_POINT expands to nothing,
+ * the ring and counters are not compiled in and the functions below are empty.
+ * every trace point bumps a counter and stores a timestamped record in a fixed size, lock-free ring,
+ * which can be exported as Chrome trace JSON (chrome://tracing, Perfetto) or as a text summary.
+ * counters are per handler type, summed over all widgets. records keep the widget, to tell instances apart.
+*/
+class EventTrace
+{
+public:
+    enum Handler
+    {
+        kHandlerSwitch,
+        kHandlerSlider,
+        kHandlerSpinner,
+        kHandlerRadio,
+        kHandlerCount
+    };
+
+    enum Point
+    {
+        kPointEventReceived,
+        kPointEventConsumed,
+        kPointValueChanged,
+        kPointCallbackFired,
+        kPointRepaintRequested,
+        kPointCount
+    };
+
+    struct Record
+    {
+        // ns, steady clock
+        uint64_t time;
+        const void *widget;
+        Handler handler;
+        Point point;
+    };
+
+    static const uint kRingSize = 4096;
+
+    static void record(Handler handler, Point point, const void *widget) noexcept;
+
+    // total over every widget using this handler type
+    static uint64_t getCount(Handler handler, Point point) noexcept;
+
+    /*
+     * copies the most recent records, oldest first. returns the number copied
+    */
+    static uint getRecords(Record *records, uint maxRecords) noexcept;
+
+    static void reset() noexcept;
+
+    /*
+     * event received to last callback or repaint of the same widget become one span
+    */
+    static bool writeChromeTrace(const char *filename);
+    static void writeSummary(FILE *file);
+
+    static const char *getHandlerName(Handler handler) noexcept;
+    static const char *getPointName(Point point) noexcept;
+};
+
+#ifdef DGL_EVENT_TRACE
+# define DGL_TRACE_POINT(handler, point, widget) EventTrace::record(handler, EventTrace::point, widget)
+#else
+# define DGL_TRACE_POINT(handler, point, widget) ((void)(handler), (void)(widget))
+#endif
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
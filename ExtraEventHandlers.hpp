@@ -6,15 +6,39 @@
 #pragma once
 
 #include "Widget.hpp"
+#include "ValueCurve.hpp"
+#include <cmath>
 #include <vector>
 
 START_NAMESPACE_DGL
 
+class ParameterQueue;
+class RepaintScheduler;
+class UndoJournal;
+
 static float clamp(float x, float upper, float lower)
 {
     return std::min(upper, std::max(x, lower));
 }
 
+/*
+ * the slider's step rule: nearest multiple of `step`, `value` as is if step is 0.
+ * use it wherever a value must land where dragging the slider would put it
+*/
+static inline float snapToStep(const float value, const float step) noexcept
+{
+    if (d_isZero(step))
+        return value;
+
+    const float rest = std::fmod(value, step);
+    return value - rest + (rest > step / 2.0f ? step : 0.0f);
+}
+
+/*
+ * repaint only `area` of `widget`, area is in widget coordinates
+*/
+void repaintWidgetArea(SubWidget *widget, const Rectangle<double> &area);
+
 // --------------------------------------------------------------------------------------------------------------------
 
 class SwitchEventHandler
@@ -27,6 +51,11 @@ public:
         virtual void switchClicked(SubWidget *widget, bool down) = 0;
     };
 
+    struct Snapshot
+    {
+        bool down;
+    };
+
     explicit SwitchEventHandler(SubWidget *self);
     explicit SwitchEventHandler(SubWidget *self, const SwitchEventHandler &other);
     SwitchEventHandler &operator=(const SwitchEventHandler &other);
@@ -35,7 +64,12 @@ public:
     bool isDown() const noexcept;
     void setDown(bool down) noexcept;
 
+    void saveState(Snapshot &state) const noexcept;
+    void restoreState(const Snapshot &state) noexcept;
+
     void setCallback(Callback *callback) noexcept;
+    void setRepaintScheduler(RepaintScheduler *scheduler) noexcept;
+    void setUndoJournal(UndoJournal *journal, uint32_t id) noexcept;
     bool mouseEvent(const Widget::MouseEvent &ev);
 
 protected:
@@ -73,6 +107,19 @@ public:
         virtual void sliderValueChanged(SubWidget *widget, float value) = 0;
     };
 
+    struct Snapshot
+    {
+        float value;
+        float valueDef;
+        float minimum;
+        float maximum;
+        float step;
+        ValueCurve::Type curve;
+        float curveShape;
+        bool usingDefault;
+        bool inverted;
+    };
+
     explicit SliderEventHandler(SubWidget *self);
     explicit SliderEventHandler(SubWidget *self, const SliderEventHandler &other);
     SliderEventHandler &operator=(const SliderEventHandler &other);
@@ -90,21 +137,71 @@ public:
     // NOTE: value is assumed to be scaled if using log
     void setDefault(float def) noexcept;
     void setSliderArea(const double x, const double y, const double w, const double h) noexcept;
+    void setThumbSize(const double w, const double h) noexcept;
     void setInverted(bool inverted) noexcept;
     bool isInverted() noexcept;
+
+    // ignored while a table curve is set, the table gives the range
     void setRange(float min, float max) noexcept;
     void setStep(float step) noexcept;
+    float getStep() const noexcept;
+
+    /*
+     * skip repainting on value changes that keep the thumb on the same pixel, off by default.
+     * only enable when nothing else drawn depends on the value, like the value as text.
+     * callbacks are sent either way
+    */
+    void setQuantizedRepaints(bool quantized) noexcept;
+
     void setUsingLogScale(bool yesNo) noexcept;
+    void setCurve(ValueCurve::Type type, float shape = 1.0f) noexcept;
+
+    /*
+     * ascending values at evenly spaced positions along the slider, see ValueCurve::setTable.
+     * the range becomes first to last value
+    */
+    void setCurveTable(const float *values, uint count);
+    const ValueCurve &getCurve() const noexcept;
+
+    void saveState(Snapshot &state) const noexcept;
+    void restoreState(const Snapshot &state, bool sendCallback = false) noexcept;
+
     void setStartPos(const int x, const int y) noexcept;
     void setEndPos(const int x, const int y) noexcept;
     void setCallback(Callback *callback) noexcept;
+    void setRepaintScheduler(RepaintScheduler *scheduler) noexcept;
+    void setUndoJournal(UndoJournal *journal, uint32_t id) noexcept;
+
+    /*
+     * value changes from user interaction are also pushed into `queue` as `parameter`
+    */
+    void setParameterQueue(ParameterQueue *queue, uint32_t parameter) noexcept;
+
+    /*
+     * collapse drag motion arriving within `frameIntervalInMs` into a single value update,
+     * 0 disables (default). call flushMotion() from an idle callback or before drawing,
+     * the exact final value is always delivered before sliderDragFinished.
+     * NanoSlider flushes from its own idle callback while coalescing is enabled
+    */
+    virtual void setMotionCoalescing(uint frameIntervalInMs);
+    bool flushMotion() noexcept;
+
+    /*
+     * area covered by the thumb at the current value,
+     * the full slider area if no thumb size is set
+    */
+    Rectangle<double> getThumbArea() const noexcept;
 
     bool mouseEvent(const Widget::MouseEvent &ev);
     bool motionEvent(const Widget::MotionEvent &ev);
     bool scrollEvent(const Widget::ScrollEvent &ev);
 
 protected:
-    // State getState() const noexcept;
+    /*
+     * called on value changes with the old and new thumb area combined,
+     * the default repaints the whole widget
+    */
+    virtual void repaintValueArea(const Rectangle<double> &area);
 
 private:
     struct PrivateData;
@@ -123,6 +220,16 @@ public:
         virtual void spinnerValueChanged(SubWidget *widget, float value) = 0;
     };
 
+    struct Snapshot
+    {
+        float value;
+        float minimum;
+        float maximum;
+        float step;
+        ValueCurve::Type curve;
+        float curveShape;
+    };
+
     explicit SpinnerEventHandler(SubWidget *self);
     explicit SpinnerEventHandler(SubWidget *self, const SpinnerEventHandler &other);
     SpinnerEventHandler &operator=(const SpinnerEventHandler &other);
@@ -132,11 +239,32 @@ public:
 
     virtual bool setValue(float value, bool sendCallback = false) noexcept;
 
+    // returns 0-1 ranged value, mapped through the curve
+    float getNormalizedValue() const noexcept;
+
     void setIncrementArea(const double x, const double y, const double w, const double h) noexcept;
     void setDecrementArea(const double x, const double y, const double w, const double h) noexcept;
+
+    // ignored while a table curve is set, the table gives the range
     void setRange(float min, float max) noexcept;
     void setStep(float step) noexcept;
+    float getStep() const noexcept;
+    void setCurve(ValueCurve::Type type, float shape = 1.0f) noexcept;
+
+    /*
+     * ascending values at evenly spaced normalized positions, see ValueCurve::setTable.
+     * the range becomes first to last value
+    */
+    void setCurveTable(const float *values, uint count);
+    const ValueCurve &getCurve() const noexcept;
+
+    void saveState(Snapshot &state) const noexcept;
+    void restoreState(const Snapshot &state, bool sendCallback = false) noexcept;
+
     void setCallback(Callback *callback) noexcept;
+    void setRepaintScheduler(RepaintScheduler *scheduler) noexcept;
+    void setUndoJournal(UndoJournal *journal, uint32_t id) noexcept;
+    void setParameterQueue(ParameterQueue *queue, uint32_t parameter) noexcept;
 
     Rectangle<double> getIncrementArea() noexcept;
     Rectangle<double> getDecrementArea() noexcept;
@@ -146,8 +274,6 @@ public:
     bool scrollEvent(const Widget::ScrollEvent &ev);
 
 protected:
-    // State getState() const noexcept;
-
 private:
     struct PrivateData;
     PrivateData *const pData;
@@ -165,6 +291,26 @@ public:
         virtual void radioValueChanged(SubWidget *widget, float value) = 0;
     };
 
+    // options are part of the widget design, not of its state
+    struct Snapshot
+    {
+        float value;
+        float minimum;
+        float maximum;
+    };
+
+    enum Layout
+    {
+        // one option per row (default)
+        kLayoutColumn,
+        // all options on a single row
+        kLayoutRow,
+        // options fill rows of `columns` cells, left to right, top to bottom
+        kLayoutGrid,
+        // hitboxes set with setOptionHitbox, hit-tested one by one
+        kLayoutCustom
+    };
+
     struct Option
     {
         const char *name;
@@ -178,6 +324,25 @@ public:
         }
     };
 
+    /*
+     * read-only view into the handler's own storage, valid until options are added or set.
+     * `version` changes whenever the options or their hitboxes change
+    */
+    template <typename T>
+    struct View
+    {
+        const T *data;
+        uint size;
+        uint32_t version;
+
+        View(const T *d, uint s, uint32_t v) noexcept
+            : data(d), size(s), version(v) {}
+
+        const T *begin() const noexcept { return data; }
+        const T *end() const noexcept { return data + size; }
+        const T &operator[](uint index) const noexcept { return data[index]; }
+    };
+
     explicit RadioEventHandler(SubWidget *self);
     explicit RadioEventHandler(SubWidget *self, const RadioEventHandler &other);
     RadioEventHandler &operator=(const RadioEventHandler &other);
@@ -188,15 +353,33 @@ public:
     virtual bool setValue(float value, bool sendCallback = false) noexcept;
 
     /*
-     * addOption also calculates the hitboxes
+     * hitboxes are laid out on first use after options, layout or size change
     */
     void addOption(const char *name, float value);
+    void setOptions(const Option *options, uint count);
 
     /* 
-     * call this after changing size 
+     * forces the hitboxes to be laid out again on next use,
+     * size changes are picked up automatically
     */
     void initHitboxes();
 
+    /*
+     * column, row and grid layouts find the clicked option from the position directly,
+     * `columns` is only used by kLayoutGrid
+    */
+    void setLayout(Layout layout, uint columns = 1);
+    void setOptionHitbox(uint index, const Rectangle<double> &hitbox);
+
+    void saveState(Snapshot &state) const noexcept;
+    void restoreState(const Snapshot &state, bool sendCallback = false) noexcept;
+
+    /*
+     * no copies, prefer these over getHitboxes/getOptions in drawing code
+    */
+    View<Option> getOptionsView();
+    View<Rectangle<double>> getHitboxesView();
+
     /*
      * clear the vector !
     */
@@ -204,10 +387,17 @@ public:
     void getOptions(std::vector<Option>&options);
 
     void setCallback(Callback *callback) noexcept;
+    void setRepaintScheduler(RepaintScheduler *scheduler) noexcept;
+    void setUndoJournal(UndoJournal *journal, uint32_t id) noexcept;
+    void setParameterQueue(ParameterQueue *queue, uint32_t parameter) noexcept;
     bool mouseEvent(const Widget::MouseEvent &ev);
 
 protected:
-    // State getState() const noexcept;
+    /*
+     * called on value changes with the old and new option hitbox combined,
+     * the default repaints the whole widget
+    */
+    virtual void repaintValueArea(const Rectangle<double> &area);
 
 private:
     struct PrivateData;
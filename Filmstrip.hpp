@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "NanoVG.hpp"
+#include <vector>
+
+START_NAMESPACE_DGL
+
+class NanoDisplayList;
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * where each frame of a filmstrip sits in its image, in 1x pixels.
+ * frames are laid out left to right in rows of `columns`, top to bottom,
+ * so 1 column is a vertical strip and `numFrames` columns a horizontal one.
+ * no drawing involved, so this can be used and checked without a GPU.
+*/
+class FilmstripLayout
+{
+public:
+    FilmstripLayout() noexcept;
+    FilmstripLayout(uint numFrames, uint frameWidth, uint frameHeight, uint columns = 1) noexcept;
+
+    uint getNumFrames() const noexcept;
+    Size<uint> getFrameSize() const noexcept;
+    Size<uint> getImageSize() const noexcept;
+
+    /*
+     * nearest frame for a 0-1 value
+    */
+    uint getFrameIndex(float normalizedValue) const noexcept;
+
+    /*
+     * source rectangle of a frame in an image `scale` times the 1x size
+    */
+    Rectangle<double> getFrameArea(uint index, double scale = 1.0) const noexcept;
+
+private:
+    uint numFrames;
+    uint frameWidth;
+    uint frameHeight;
+    uint columns;
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * a pre-rendered filmstrip image, shared by every widget showing it.
+ * the image can come in several resolutions, the smallest one that is at least as large as the
+ * display scale factor is used. images are created on first draw in the NanoVG context drawn into,
+ * so all widgets sharing a filmstrip must share that context too (as NanoSubWidgets of the same
+ * NanoTopLevelWidget do), and the filmstrip must be destroyed before it.
+ * drawing a frame is a single image filled rectangle.
+*/
+class Filmstrip
+{
+public:
+    static const uint kMaxVariants = 4;
+
+    explicit Filmstrip(const FilmstripLayout &layout);
+
+    const FilmstripLayout &getLayout() const noexcept;
+
+    /*
+     * `scale` is the resolution of the image relative to the layout, e.g. 2 for a @2x image.
+     * memory images are not copied and must stay valid for the lifetime of the filmstrip
+    */
+    bool addImageFromFile(const char *filename, double scale = 1.0);
+    bool addImageFromMemory(const uchar *data, uint dataSize, double scale = 1.0);
+
+    /*
+     * index of the image used at `scaleFactor`, -1 if there are none
+    */
+    int selectVariant(double scaleFactor) const noexcept;
+
+    /*
+     * draws the frame for `normalizedValue` stretched over `area`
+    */
+    void draw(NanoVG &nvg, const Rectangle<double> &area, float normalizedValue, double scaleFactor = 1.0);
+
+    /*
+     * records the same drawing into `list`, `nvg` is only used to load the image and create its pattern
+    */
+    void draw(NanoDisplayList &list, NanoVG &nvg, const Rectangle<double> &area, float normalizedValue,
+              double scaleFactor = 1.0);
+
+private:
+    struct Variant
+    {
+        double scale;
+        std::vector<char> filename;
+        const uchar *data;
+        uint dataSize;
+        NanoImage image;
+        bool failed;
+    };
+
+    const FilmstripLayout layout;
+    Variant variants[kMaxVariants];
+    uint numVariants;
+
+    Variant *addVariant(double scale);
+    bool loadImage(NanoVG &nvg, Variant &variant);
+    bool getFramePaint(NanoVG &nvg, const Rectangle<double> &area, float normalizedValue, double scaleFactor,
+                       NanoVG::Paint &paint);
+
+    DISTRHO_DECLARE_NON_COPYABLE(Filmstrip)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "Base.hpp"
+#include <atomic>
+#include <cstdint>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * single producer, single consumer ring of fixed size float frames, e.g. meter levels or FFT magnitudes,
+ * for handing display data from the DSP to the UI.
+ * both sides are wait-free and never allocate, a full queue drops the new frame.
+ * frames can be written and read in place, without copying.
+*/
+class FrameQueue
+{
+public:
+    /*
+     * capacity is rounded up to a power of 2
+    */
+    FrameQueue(uint32_t frameSize, uint32_t capacity = 8);
+    ~FrameQueue();
+
+    uint32_t getFrameSize() const noexcept;
+
+    /*
+     * DSP thread. fill the frame returned by beginWrite() and then call commitWrite(),
+     * beginWrite() returns nullptr when the queue is full
+    */
+    float *beginWrite() noexcept;
+    void commitWrite() noexcept;
+    bool push(const float *frame) noexcept;
+
+    /*
+     * UI thread. front() returns the oldest frame or nullptr if there is none, pop() releases it
+    */
+    const float *front() const noexcept;
+    void pop() noexcept;
+    bool isEmpty() const noexcept;
+
+    /*
+     * UI thread, drops everything queued
+    */
+    void clear() noexcept;
+
+private:
+    float *const buffer;
+    const uint32_t frameSize;
+    const uint32_t mask;
+
+    // writeIndex is only written by the DSP thread, readIndex only by the UI thread.
+    // padded onto separate cache lines, alignas on members of heap objects needs C++17
+    char padding1[64];
+    std::atomic<uint32_t> writeIndex;
+    char padding2[64 - sizeof(std::atomic<uint32_t>)];
+    std::atomic<uint32_t> readIndex;
+    char padding3[64 - sizeof(std::atomic<uint32_t>)];
+
+    DISTRHO_DECLARE_NON_COPYABLE(FrameQueue)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "Base.hpp"
+#include <cstddef>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * bump allocator for event handler state.
+ * handlers constructed while a HandlerArena::Scope is alive take their private data from that arena,
+ * packed together in large blocks instead of one heap allocation each.
+ * the blocks are released in one go when the arena is destroyed, so the arena must outlive every
+ * handler created from it (declare it before the widgets in your UI class).
+ * UI thread only.
+*/
+class HandlerArena
+{
+public:
+    explicit HandlerArena(std::size_t blockSize = 64 * 1024);
+    ~HandlerArena();
+
+    void *allocate(std::size_t size);
+
+    std::size_t getBytesUsed() const noexcept;
+    std::size_t getBytesReserved() const noexcept;
+    uint getNumAllocations() const noexcept;
+
+    class Scope
+    {
+    public:
+        explicit Scope(HandlerArena &arena) noexcept;
+        ~Scope() noexcept;
+
+    private:
+        HandlerArena *const previous;
+
+        DISTRHO_DECLARE_NON_COPYABLE(Scope)
+    };
+
+    static HandlerArena *getCurrent() noexcept;
+
+    /*
+     * used by the handlers, takes memory from the current arena if there is one, the heap otherwise
+    */
+    static void *allocateHandlerData(std::size_t size);
+    static void releaseHandlerData(void *ptr) noexcept;
+
+private:
+    struct Block;
+
+    const std::size_t blockSize;
+    Block *blocks;
+    std::size_t bytesUsed;
+    std::size_t bytesReserved;
+    uint numAllocations;
+    uint numLiveAllocations;
+
+    static HandlerArena *current;
+
+    Block *createBlock(std::size_t size);
+
+    DISTRHO_DECLARE_NON_COPYABLE(HandlerArena)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
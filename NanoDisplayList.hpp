@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "NanoVG.hpp"
+#include <cstdio>
+#include <initializer_list>
+#include <vector>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * records NanoVG drawing commands into a compact buffer that can be replayed as-is.
+ * recording is CPU only, a NanoVG context is needed just for replay().
+ *
+ * typical use in onNanoDisplay():
+ *
+ *     const uint32_t key = static_cast<uint32_t>(getNormalizedValue() * getHeight());
+ *
+ *     if (!displayList.isRecorded(key))
+ *     {
+ *         displayList.begin(key);
+ *         drawInto(displayList); // same calls as on NanoVG
+ *         displayList.end();
+ *     }
+ *
+ *     displayList.replay(*this);
+ *
+ * recording needs no GPU, so getStats() and write() measure and diff recorded drawing headlessly.
+ * this only covers drawing code written against NanoDisplayList, like drawInto() above.
+ * widgets drawing straight onto NanoVG in onNanoDisplay(), such as NanoSlider or NanoKnob subclasses,
+ * cannot be redirected into a display list, and nothing here renders pixels.
+*/
+class NanoDisplayList
+{
+public:
+    NanoDisplayList();
+
+    bool isRecorded(uint32_t key) const noexcept;
+
+    /*
+     * clears the previous recording, keeping its memory around
+    */
+    void begin(uint32_t key);
+    void end() noexcept;
+    void clear() noexcept;
+
+    void replay(NanoVG &nvg) const;
+
+    uint getNumCommands() const noexcept;
+
+    struct Stats
+    {
+        // fills, strokes and text runs, each is at least one GL draw call
+        uint drawCalls;
+        uint fills;
+        uint strokes;
+        uint textRuns;
+        // path points handed to nanovg with shapes expanded, curves counted by their control points
+        uint vertices;
+        // time spent recording, seconds from begin() to end(). not a frame or draw time
+        double recordingSeconds;
+    };
+
+    /*
+     * counted from the commands in end(), recording itself costs the same as before
+    */
+    const Stats &getStats() const noexcept;
+
+    /*
+     * writes the recorded commands as text, one per line, for diffing against a known good file
+    */
+    void write(FILE *file) const;
+
+    // recordable commands, same meaning as in NanoVG
+    void save();
+    void restore();
+    void resetTransform();
+    void translate(float x, float y);
+    void rotate(float angle);
+    void scale(float x, float y);
+    void globalAlpha(float alpha);
+    void scissor(float x, float y, float w, float h);
+    void intersectScissor(float x, float y, float w, float h);
+    void resetScissor();
+
+    void beginPath();
+    void moveTo(float x, float y);
+    void lineTo(float x, float y);
+    void bezierTo(float c1x, float c1y, float c2x, float c2y, float x, float y);
+    void quadTo(float cx, float cy, float x, float y);
+    void arcTo(float x1, float y1, float x2, float y2, float radius);
+    void arc(float cx, float cy, float r, float a0, float a1, NanoVG::Winding dir);
+    void closePath();
+    void pathWinding(NanoVG::Winding dir);
+    void rect(float x, float y, float w, float h);
+    void roundedRect(float x, float y, float w, float h, float r);
+    void ellipse(float cx, float cy, float rx, float ry);
+    void circle(float cx, float cy, float r);
+
+    void fillColor(const Color &color);
+    void strokeColor(const Color &color);
+    void fillPaint(const NanoVG::Paint &paint);
+    void strokePaint(const NanoVG::Paint &paint);
+    void strokeWidth(float size);
+    void lineCap(NanoVG::LineCap cap = NanoVG::BUTT);
+    void lineJoin(NanoVG::LineCap join = NanoVG::MITER);
+    void miterLimit(float limit);
+    void fillLinearGradient(float sx, float sy, float ex, float ey, const Color &icol, const Color &ocol);
+    void fillRadialGradient(float cx, float cy, float inr, float outr, const Color &icol, const Color &ocol);
+    void fill();
+    void stroke();
+
+    /*
+     * paints computed the same way as nanovg does, no context needed.
+     * image patterns refer to an image of the context replayed into, get those from NanoVG::imagePattern()
+    */
+    static NanoVG::Paint linearGradient(float sx, float sy, float ex, float ey, const Color &icol, const Color &ocol);
+    static NanoVG::Paint boxGradient(float x, float y, float w, float h, float r, float f,
+                                     const Color &icol, const Color &ocol);
+    static NanoVG::Paint radialGradient(float cx, float cy, float inr, float outr, const Color &icol, const Color &ocol);
+
+    void fontFace(const char *font);
+    void fontFaceId(NanoVG::FontId font);
+    void fontSize(float size);
+    void textAlign(int align);
+    void text(float x, float y, const char *string, const char *end = nullptr);
+    void textBox(float x, float y, float breakRowWidth, const char *string, const char *end = nullptr);
+
+private:
+    enum Op
+    {
+        kOpSave,
+        kOpRestore,
+        kOpResetTransform,
+        kOpTranslate,
+        kOpRotate,
+        kOpScale,
+        kOpGlobalAlpha,
+        kOpScissor,
+        kOpIntersectScissor,
+        kOpResetScissor,
+        kOpBeginPath,
+        kOpMoveTo,
+        kOpLineTo,
+        kOpBezierTo,
+        kOpQuadTo,
+        kOpArcTo,
+        kOpArc,
+        kOpClosePath,
+        kOpPathWinding,
+        kOpRect,
+        kOpRoundedRect,
+        kOpEllipse,
+        kOpCircle,
+        kOpFillColor,
+        kOpStrokeColor,
+        kOpFillPaint,
+        kOpStrokePaint,
+        kOpStrokeWidth,
+        kOpLineCap,
+        kOpLineJoin,
+        kOpMiterLimit,
+        kOpFillLinearGradient,
+        kOpFillRadialGradient,
+        kOpFill,
+        kOpStroke,
+        kOpFontFace,
+        kOpFontFaceId,
+        kOpFontSize,
+        kOpTextAlign,
+        kOpText,
+        kOpTextBox
+    };
+
+    struct Command
+    {
+        uint8_t op;
+        // index of the first argument in `args`
+        uint32_t index;
+        // offset of the string in `strings` for text and fonts, image id for paints
+        uint32_t data;
+    };
+
+    std::vector<Command> commands;
+    std::vector<float> args;
+    std::vector<char> strings;
+
+    uint32_t key;
+    bool recorded;
+    bool recording;
+    Stats stats;
+    double beginTime;
+
+    void updateStats() noexcept;
+
+    /*
+     * all recorders go through add() first and stop if it returns false, i.e. outside begin()/end()
+    */
+    bool add(Op op, std::initializer_list<float> values = {}, uint32_t data = 0);
+    void addColor(const Color &color);
+    void addPaint(Op op, const NanoVG::Paint &paint);
+    void addString(const char *string, const char *end);
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "NanoVG.hpp"
+#include "Filmstrip.hpp"
 #include "EventHandlers.hpp"
 
 START_NAMESPACE_DGL
@@ -16,12 +17,25 @@ class NanoKnob : public NanoSubWidget,
 public:
     explicit NanoKnob(Widget *parent, KnobEventHandler::Callback *cb);
 
+    /*
+     * shared, not owned. nullptr (default) disables filmstrip drawing
+    */
+    void setFilmstrip(Filmstrip *filmstrip) noexcept;
+
 protected:
+    /*
+     * draws the filmstrip frame for the current value over the whole widget,
+     * returns false if there is no filmstrip. meant to be called from onNanoDisplay()
+    */
+    bool drawFilmstrip();
+
     bool onMouse(const MouseEvent &ev) override;
     bool onMotion(const MotionEvent &ev) override;
     bool onScroll(const ScrollEvent &ev) override;
 
 private:
+    Filmstrip *filmstrip;
+
     DISTRHO_LEAK_DETECTOR(NanoKnob)
 };
 
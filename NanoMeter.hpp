@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "NanoVG.hpp"
+#include "FrameQueue.hpp"
+#include "ValueCurve.hpp"
+#include <vector>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * peak and RMS level meter for any number of channels, drawn as one bar per channel.
+ * the DSP pushes one peak and RMS amplitude per channel through a wait-free FrameQueue,
+ * update() drains it and runs the ballistics for all channels at once, then repaints if a bar moved.
+ * levels are shown in dB, mapped to the bar height through a ValueCurve (linear from -60 to +6 dB by default).
+ * all bars are drawn as a single path per colour, however many channels there are.
+ * the meter registers itself as idle callback and updates every 16 ms, see setRefreshInterval().
+*/
+class NanoMeter : public NanoSubWidget,
+                  public IdleCallback
+{
+public:
+    explicit NanoMeter(Widget *parent, uint numChannels, uint queueCapacity = 16);
+    ~NanoMeter() override;
+
+    uint getNumChannels() const noexcept;
+
+    /*
+     * DSP thread, one linear amplitude per channel, `rms` may be nullptr.
+     * returns false (and drops the levels) when the UI falls behind
+    */
+    bool pushLevels(const float *peaks, const float *rms = nullptr) noexcept;
+
+    void setRange(float minDb, float maxDb) noexcept;
+    void setCurve(ValueCurve::Type type, float shape = 1.0f) noexcept;
+
+    /*
+     * times in ms. attack and release are the time constants of the bars,
+     * the peak hold stays for `hold` and then falls with `holdRelease`
+    */
+    void setBallistics(float attack, float release, float hold, float holdRelease) noexcept;
+
+    void setColors(const Color &background, const Color &peak, const Color &rms, const Color &hold) noexcept;
+    void setChannelGap(float gap) noexcept;
+
+    /*
+     * how often the meter's own idle callback runs update(), 16 ms by default.
+     * 0 unregisters it, the UI must then call update() itself
+    */
+    void setRefreshInterval(uint intervalInMs);
+
+    /*
+     * UI thread, `deltaTime` in seconds since the last update. returns true if the meter needs a repaint,
+     * which has then already been requested
+    */
+    bool update(double deltaTime) noexcept;
+
+    /*
+     * 0-1 display positions, one per channel
+    */
+    const float *getPeakLevels() const noexcept;
+    const float *getRmsLevels() const noexcept;
+    const float *getHoldLevels() const noexcept;
+
+protected:
+    void onNanoDisplay() override;
+    void idleCallback() override;
+
+private:
+    const uint numChannels;
+    FrameQueue queue;
+    ValueCurve curve;
+
+    // peaks followed by RMS, so both go through each pass together
+    std::vector<float> targets;
+    std::vector<float> levels;
+    std::vector<float> holds;
+    std::vector<float> holdTimes;
+
+    float attackTime;
+    float releaseTime;
+    float holdTime;
+    float holdReleaseTime;
+    float channelGap;
+    double lastUpdate;
+    bool idleRegistered;
+
+    Color backgroundColor;
+    Color peakColor;
+    Color rmsColor;
+    Color holdColor;
+
+    void addBars(const float *values, float thickness);
+
+    DISTRHO_LEAK_DETECTOR(NanoMeter)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
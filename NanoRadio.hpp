@@ -17,6 +17,7 @@ public:
 
 protected:
     bool onMouse(const MouseEvent &ev) override;
+    void repaintValueArea(const Rectangle<double> &area) override;
 
 private:
     DISTRHO_LEAK_DETECTOR(NanoRadio)
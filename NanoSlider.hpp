@@ -6,21 +6,46 @@
 #pragma once
 
 #include "NanoVG.hpp"
+#include "Filmstrip.hpp"
 #include "ExtraEventHandlers.hpp"
 
 START_NAMESPACE_DGL
 
 class NanoSlider : public NanoSubWidget,
-                   public SliderEventHandler
+                   public SliderEventHandler,
+                   public IdleCallback
 {
 public:
     explicit NanoSlider(Widget *parent, SliderEventHandler::Callback *cb);
+    ~NanoSlider() override;
+
+    /*
+     * also registers the slider as idle callback at `frameIntervalInMs`, so the last
+     * coalesced drag value shows up when the pointer stops moving
+    */
+    void setMotionCoalescing(uint frameIntervalInMs) override;
+
+    /*
+     * shared, not owned. nullptr (default) disables filmstrip drawing
+    */
+    void setFilmstrip(Filmstrip *filmstrip) noexcept;
 
 protected:
+    /*
+     * draws the filmstrip frame for the current value over the whole widget,
+     * returns false if there is no filmstrip. meant to be called from onNanoDisplay()
+    */
+    bool drawFilmstrip();
+
     bool onMouse(const MouseEvent &ev) override;
     bool onMotion(const MotionEvent &ev) override;
+    void repaintValueArea(const Rectangle<double> &area) override;
+    void idleCallback() override;
 
 private:
+    Filmstrip *filmstrip;
+    bool idleRegistered;
+
     DISTRHO_LEAK_DETECTOR(NanoSlider)
 };
 
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "NanoVG.hpp"
+#include "FrameQueue.hpp"
+#include "ValueCurve.hpp"
+#include <vector>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * spectrum analyzer display for FFT magnitude frames pushed from the DSP through a wait-free FrameQueue.
+ * the bins are mapped onto one column per pixel on a log frequency axis (the kCurveLog mapping of ValueCurve),
+ * through a bin to column table that is only rebuilt when the width or the frequency settings change.
+ * columns spanning several bins take their maximum or average, narrower columns interpolate between bins.
+ * levels are shown in dB, with per-frame smoothing and falling peaks.
+ * the spectrum registers itself as idle callback and updates every 16 ms, see setRefreshInterval().
+*/
+class NanoSpectrum : public NanoSubWidget,
+                     public IdleCallback
+{
+public:
+    enum Reduction
+    {
+        kReductionMax,
+        kReductionAverage
+    };
+
+    /*
+     * `numBins` magnitudes per frame, evenly spaced from 0 Hz to Nyquist inclusive (fftSize / 2 + 1)
+    */
+    explicit NanoSpectrum(Widget *parent, uint numBins, uint queueCapacity = 4);
+    ~NanoSpectrum() override;
+
+    uint getNumBins() const noexcept;
+
+    /*
+     * DSP thread, `numBins` linear magnitudes. returns false (and drops the frame) when the UI falls behind
+    */
+    bool pushMagnitudes(const float *magnitudes) noexcept;
+
+    void setSampleRate(double sampleRate) noexcept;
+    void setFrequencyRange(float minHz, float maxHz) noexcept;
+    void setLevelRange(float minDb, float maxDb) noexcept;
+    void setReduction(Reduction reduction) noexcept;
+
+    /*
+     * times in ms, `peakRelease` is the time for a peak to fall over the whole level range
+    */
+    void setSmoothing(float attack, float release) noexcept;
+    void setPeakRelease(float peakRelease) noexcept;
+
+    void setColors(const Color &background, const Color &area, const Color &line, const Color &peak) noexcept;
+
+    /*
+     * how often the spectrum's own idle callback runs update(), 16 ms by default.
+     * 0 unregisters it, the UI must then call update() itself
+    */
+    void setRefreshInterval(uint intervalInMs);
+
+    /*
+     * UI thread, `deltaTime` in seconds since the last update. returns true if a repaint was requested
+    */
+    bool update(double deltaTime);
+
+    /*
+     * 0-1 display positions, one per column
+    */
+    uint getNumColumns() const noexcept;
+    const float *getLevels() const noexcept;
+    const float *getPeaks() const noexcept;
+
+protected:
+    void onNanoDisplay() override;
+    void idleCallback() override;
+
+private:
+    struct Column
+    {
+        uint32_t first;
+        // 0 means interpolate between `first` and the next bin
+        uint32_t count;
+        float fraction;
+    };
+
+    const uint numBins;
+    FrameQueue queue;
+    ValueCurve frequencyCurve;
+    ValueCurve levelCurve;
+    Reduction reduction;
+
+    std::vector<float> magnitudes;
+    std::vector<Column> table;
+    std::vector<float> targets;
+    std::vector<float> levels;
+    std::vector<float> peaks;
+
+    double sampleRate;
+    bool tableDirty;
+    float attackTime;
+    float releaseTime;
+    float peakReleaseTime;
+    double lastUpdate;
+    bool idleRegistered;
+
+    Color backgroundColor;
+    Color areaColor;
+    Color lineColor;
+    Color peakColor;
+
+    void buildTable();
+    void addLine(const float *values);
+
+    DISTRHO_LEAK_DETECTOR(NanoSpectrum)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "NanoVG.hpp"
+#include <vector>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * container for many child widgets.
+ * instead of offering every event to every child, the panel looks up the child under the cursor
+ * in a grid of cells and only gives the event to that child.
+ * a child that accepts a mouse press captures all events until the button is released,
+ * so a dragged slider gets its motion without any lookup.
+ *
+ * children are created with the panel as parent and then registered with addWidget().
+ * call updateIndex() after moving or resizing children.
+*/
+class NanoWidgetPanel : public NanoSubWidget
+{
+public:
+    explicit NanoWidgetPanel(Widget *parent, uint cellSize = 64);
+
+    void addWidget(SubWidget *widget);
+    void removeWidget(SubWidget *widget);
+    void updateIndex() noexcept;
+
+    // the child at `x`, `y` relative to the panel, if any
+    SubWidget *getWidgetAt(double x, double y);
+    SubWidget *getCapturingWidget() const noexcept;
+
+protected:
+    // draws nothing, children draw themselves
+    void onNanoDisplay() override;
+    bool onMouse(const MouseEvent &ev) override;
+    bool onMotion(const MotionEvent &ev) override;
+    bool onScroll(const ScrollEvent &ev) override;
+    void onResize(const ResizeEvent &ev) override;
+
+private:
+    struct Child
+    {
+        SubWidget *widget;
+        Rectangle<double> area;
+    };
+
+    const uint cellSize;
+    uint numColumns;
+    uint numRows;
+    bool indexDirty;
+
+    std::vector<Child> children;
+    // child indices per cell, in insertion order
+    std::vector<std::vector<uint>> cells;
+
+    SubWidget *capturing;
+    SubWidget *hovered;
+
+    void rebuildIndex();
+
+    DISTRHO_LEAK_DETECTOR(NanoWidgetPanel)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
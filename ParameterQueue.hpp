@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "Base.hpp"
+#include <atomic>
+#include <cstdint>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * single producer, single consumer ring buffer for handing parameter changes from the UI to the DSP,
+ * meant for plugins using DISTRHO_PLUGIN_WANT_DIRECT_ACCESS.
+ * the UI thread pushes, the audio thread drains at block start. neither side ever locks or allocates.
+*/
+class ParameterQueue
+{
+public:
+    struct Event
+    {
+        uint32_t parameter;
+        float value;
+        // time of the originating widget event, in ms
+        uint32_t time;
+    };
+
+    /*
+     * capacity is rounded up to a power of 2
+    */
+    explicit ParameterQueue(uint32_t capacity = 1024);
+    ~ParameterQueue();
+
+    /*
+     * UI thread, returns false (and drops the event) when the queue is full
+    */
+    bool push(uint32_t parameter, float value, uint32_t time) noexcept;
+
+    /*
+     * audio thread
+    */
+    bool pop(Event &event) noexcept;
+    uint32_t drain(Event *events, uint32_t maxEvents) noexcept;
+    bool isEmpty() const noexcept;
+
+    uint32_t getCapacity() const noexcept;
+
+private:
+    Event *const buffer;
+    const uint32_t mask;
+
+    // writeIndex is only written by the UI thread, readIndex only by the audio thread.
+    // padded onto separate cache lines, alignas on members of heap objects needs C++17
+    char padding1[64];
+    std::atomic<uint32_t> writeIndex;
+    char padding2[64 - sizeof(std::atomic<uint32_t>)];
+    std::atomic<uint32_t> readIndex;
+    char padding3[64 - sizeof(std::atomic<uint32_t>)];
+
+    DISTRHO_DECLARE_NON_COPYABLE(ParameterQueue)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
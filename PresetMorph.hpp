@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "ExtraEventHandlers.hpp"
+#include <vector>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * morphs the values of many sliders and spinners between two snapshots.
+ * snapshots are kept as contiguous arrays of normalized values and interpolated in one pass,
+ * each result is mapped back through its handler's curve and step.
+ * all handlers are updated inside a single ValueTransaction, so each changed widget is repainted
+ * once per morph() call.
+*/
+class PresetMorph
+{
+public:
+    enum Snapshot
+    {
+        kSnapshotA,
+        kSnapshotB
+    };
+
+    PresetMorph();
+
+    /*
+     * returns the index of the handler in the snapshot arrays
+    */
+    uint addSlider(SliderEventHandler *slider);
+    uint addSpinner(SpinnerEventHandler *spinner);
+    uint getNumHandlers() const noexcept;
+
+    /*
+     * store the current values of all handlers
+    */
+    void capture(Snapshot snapshot);
+
+    /*
+     * `normalizedValues` holds one 0-1 value per handler, in the order they were added
+    */
+    void setSnapshot(Snapshot snapshot, const float *normalizedValues);
+    const float *getSnapshot(Snapshot snapshot) const noexcept;
+
+    /*
+     * 0 is snapshot A, 1 is snapshot B. returns the number of handlers whose value changed
+    */
+    uint morph(float position, bool sendCallbacks = true);
+
+private:
+    struct Target
+    {
+        SliderEventHandler *slider;
+        SpinnerEventHandler *spinner;
+    };
+
+    std::vector<Target> targets;
+    std::vector<float> snapshotA;
+    std::vector<float> snapshotB;
+    std::vector<float> morphed;
+
+    uint add(SliderEventHandler *slider, SpinnerEventHandler *spinner);
+
+    DISTRHO_DECLARE_NON_COPYABLE(PresetMorph)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "SubWidget.hpp"
+#include <vector>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * collects repaint requests from handlers and flushes them at most `maxFrameRate` times per second,
+ * so host automation arriving at any rate repaints each widget at most once per frame.
+ * register it as idle callback on the window, e.g. `getWindow().addIdleCallback(&scheduler, 10)`,
+ * and pass it to the handlers with setRepaintScheduler().
+ * when only a value area is dirty, the handler that marked it repaints it through its repaintValueArea(),
+ * so a handler that does not override that still repaints the whole widget.
+*/
+class RepaintScheduler : public IdleCallback
+{
+public:
+    enum Policy
+    {
+        kRepaintAlways,
+        // drop requests for hidden widgets, they are fully drawn when shown again
+        kRepaintWhenVisible
+    };
+
+    struct Stats
+    {
+        uint64_t requests;
+        // requests merged into one already pending
+        uint64_t coalesced;
+        uint64_t repaints;
+        uint64_t skippedHidden;
+        uint64_t flushes;
+    };
+
+    // implemented by the handlers that mark value areas
+    struct AreaRepainter
+    {
+        virtual ~AreaRepainter() {}
+        virtual void repaintArea(const Rectangle<double> &area) = 0;
+    };
+
+    explicit RepaintScheduler(double maxFrameRate = 60.0);
+
+    void setMaxFrameRate(double maxFrameRate) noexcept;
+    void setPolicy(Policy policy) noexcept;
+
+    /*
+     * an invalid `area` means the whole widget.
+     * valid areas are flushed through `repainter`, or repaintWidgetArea() without one
+    */
+    void markDirty(SubWidget *widget, const Rectangle<double> &area = Rectangle<double>(),
+                   AreaRepainter *repainter = nullptr);
+
+    /*
+     * drop pending requests, call before `widget` is destroyed
+    */
+    void cancel(SubWidget *widget) noexcept;
+
+    /*
+     * repaint everything pending right away, returns the number of widgets repainted
+    */
+    uint flush();
+
+    const Stats &getStats() const noexcept;
+    void resetStats() noexcept;
+
+protected:
+    // flushes when a frame interval has passed since the last flush
+    void idleCallback() override;
+
+private:
+    struct Entry
+    {
+        SubWidget *widget;
+        AreaRepainter *repainter;
+        Rectangle<double> area;
+        bool full;
+    };
+
+    double frameInterval;
+    double lastFlush;
+    Policy policy;
+    Stats stats;
+
+    std::vector<Entry> pending;
+    // open addressing index into `pending`, 0 is empty, otherwise index + 1
+    std::vector<uint> slots;
+
+    uint findSlot(const SubWidget *widget) const noexcept;
+    void growSlots();
+
+    DISTRHO_DECLARE_NON_COPYABLE(RepaintScheduler)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "ExtraEventHandlers.hpp"
+#include <vector>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * saves and restores the full state of a set of handlers as one flat binary buffer.
+ * layout: a 12 byte header (magic, version, number of handlers) followed by one record per handler,
+ * a 1 byte type tag and the fixed size fields of its Snapshot. values are stored in host byte order.
+ * read() validates the whole buffer, ranges and values included, before touching any handler,
+ * then restores them in a single pass inside one ValueTransaction, so every widget is repainted once.
+ * a transaction already running is joined instead, and commits the restored values with its own.
+ * handlers using a kCurveTable curve cannot be saved, the table is part of the widget design.
+ * handlers must be added in the same order when saving and restoring.
+*/
+class StateSerializer
+{
+public:
+    static const uint32_t kVersion = 1;
+
+    StateSerializer();
+
+    void addSwitch(SwitchEventHandler *handler);
+    void addSlider(SliderEventHandler *handler);
+    void addSpinner(SpinnerEventHandler *handler);
+    void addRadio(RadioEventHandler *handler);
+    uint getNumHandlers() const noexcept;
+    void clear() noexcept;
+
+    /*
+     * size in bytes of the buffer write() produces, does not depend on the handler values
+    */
+    size_t getSize() const noexcept;
+
+    /*
+     * returns the number of bytes written,
+     * 0 if `size` is too small or a handler uses a kCurveTable curve
+    */
+    size_t write(uint8_t *data, size_t size) const noexcept;
+    void write(std::vector<uint8_t> &buffer) const;
+
+    /*
+     * returns false and leaves all handlers untouched if the buffer does not match the added handlers
+    */
+    bool read(const uint8_t *data, size_t size, bool sendCallbacks = false);
+
+private:
+    enum Type
+    {
+        kTypeSwitch = 1,
+        kTypeSlider,
+        kTypeSpinner,
+        kTypeRadio
+    };
+
+    struct Entry
+    {
+        Type type;
+        void *handler;
+    };
+
+    std::vector<Entry> entries;
+    size_t size;
+
+    void add(Type type, void *handler, size_t recordSize);
+
+    DISTRHO_DECLARE_NON_COPYABLE(StateSerializer)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "Base.hpp"
+#include <cstdint>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * undo/redo history of handler value changes, in a ring of fixed size.
+ * when full the oldest entries are overwritten, recording never allocates.
+ *
+ * handlers given a journal with setUndoJournal() record changes made by the user only:
+ * a whole slider drag becomes one entry, repeated spinner clicks or scrolls on the same widget
+ * within the merge window are merged into one.
+ * values applied with setValue() are not recorded, so undo() and redo() results can be applied
+ * with setValue(entry.oldValue, true) and setValue(entry.newValue, true).
+*/
+class UndoJournal
+{
+public:
+    struct Entry
+    {
+        uint32_t id;
+        float oldValue;
+        float newValue;
+        // event time of the last change, in ms
+        uint32_t time;
+    };
+
+    explicit UndoJournal(uint capacity = 256, uint mergeWindowInMs = 500);
+    ~UndoJournal();
+
+    /*
+     * with `merge`, a change to the same id as the newest entry within the merge window extends that entry
+    */
+    void record(uint32_t id, float oldValue, float newValue, uint32_t time, bool merge = false) noexcept;
+
+    bool canUndo() const noexcept;
+    bool canRedo() const noexcept;
+
+    /*
+     * return the entry to revert or re-apply
+    */
+    bool undo(Entry &entry) noexcept;
+    bool redo(Entry &entry) noexcept;
+
+    void clear() noexcept;
+    uint getNumEntries() const noexcept;
+
+private:
+    Entry *const entries;
+    const uint capacity;
+    const uint mergeWindow;
+
+    // ring index of the oldest entry
+    uint first;
+    // entries stored, and how many of those are applied (the rest can be redone)
+    uint count;
+    uint position;
+    // the newest entry may still be extended
+    bool mergeable;
+
+    Entry &at(uint index) const noexcept;
+
+    DISTRHO_DECLARE_NON_COPYABLE(UndoJournal)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "Base.hpp"
+#include <vector>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * maps values within a range to 0-1 and back.
+ * all coefficients are computed when the range or type changes, not on every call.
+*/
+class ValueCurve
+{
+public:
+    enum Type
+    {
+        kCurveLinear,
+        // range must be > 0, maps linearly until it is
+        kCurveLog,
+        // shape is the curvature, > 0 bends towards the maximum, < 0 towards the minimum
+        kCurveExponential,
+        // shape is the skew, normalized = pow(linear, skew)
+        kCurvePower,
+        // values are in dB, normalized is linear in amplitude
+        kCurveDecibel,
+        // values from setTable()
+        kCurveTable
+    };
+
+    ValueCurve() noexcept;
+
+    /*
+     * ignored while the type is kCurveTable, the table sets the range
+    */
+    void setRange(float min, float max) noexcept;
+    void setType(Type type, float shape = 1.0f) noexcept;
+
+    /*
+     * ascending values at evenly spaced normalized positions, switches to kCurveTable.
+     * the range becomes first to last value, also when switching back to the table with setType()
+    */
+    void setTable(const float *values, uint count);
+
+    /*
+     * 0 disables the lookup tables (default).
+     * with lookup tables every curve maps through linear interpolation, which is cheaper and
+     * vectorizes, at the cost of some precision
+    */
+    void setLookupTableSize(uint size);
+
+    Type getType() const noexcept;
+    float getShape() const noexcept;
+    float getMinimum() const noexcept;
+    float getMaximum() const noexcept;
+
+    float normalize(float value) const noexcept;
+    float denormalize(float normalized) const noexcept;
+
+    /*
+     * batch versions, `values` and `results` may be the same array
+    */
+    void normalize(const float *values, float *results, uint count) const noexcept;
+    void denormalize(const float *normalized, float *results, uint count) const noexcept;
+
+private:
+    Type type;
+    // the type actually applied, kCurveLog falls back to linear while the range includes 0
+    Type active;
+    float shape;
+    float minimum;
+    float maximum;
+
+    // precomputed from the above
+    float range;
+    float invRange;
+    float offset;
+    float scale;
+    float invScale;
+    float extra;
+
+    std::vector<float> table;
+    std::vector<float> normalizeLut;
+    std::vector<float> denormalizeLut;
+
+    void update();
+    float computeNormalized(float value) const noexcept;
+    float computeDenormalized(float normalized) const noexcept;
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "NanoVG.hpp"
+#include <string>
+#include <vector>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * formatted value text and its measured bounds, for drawing a handler's value.
+ * the text is only formatted again when the value changes at display precision,
+ * and only measured again when the text, font, size or alignment changes.
+ * opt-in and standalone, no handler owns one: keep the step in sync with the handler's
+ * setStep() yourself. the range does not affect the text, so range changes need no invalidation.
+*/
+class ValueTextCache
+{
+public:
+    explicit ValueTextCache(int precision = 2, const char *unit = nullptr);
+
+    /*
+     * all of these invalidate the cache
+    */
+    void setPrecision(int decimals) noexcept;
+    void setUnit(const char *unit) noexcept;
+    void setStep(float step) noexcept;
+    void invalidate() noexcept;
+
+    const char *getText(float value) noexcept;
+
+    /*
+     * bounds are relative to the text origin.
+     * sets font, size and alignment on `nvg` when measuring
+    */
+    const Rectangle<float> &getBounds(NanoVG &nvg, float value, NanoVG::FontId font, float size, int align);
+
+private:
+    int precision;
+    double precisionScale;
+    float step;
+    char unit[16];
+    char text[64];
+
+    bool textValid;
+    long long textKey;
+
+    bool boundsValid;
+    NanoVG::FontId boundsFont;
+    float boundsSize;
+    int boundsAlign;
+    Rectangle<float> bounds;
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * measured bounds of labels, such as RadioEventHandler option names, by index.
+ * labels are compared by contents, so a reused buffer with new text is measured again
+*/
+class LabelBoundsCache
+{
+public:
+    const Rectangle<float> &getBounds(NanoVG &nvg, uint index, const char *label,
+                                      NanoVG::FontId font, float size, int align);
+    void invalidate() noexcept;
+
+private:
+    struct Entry
+    {
+        std::string label;
+        NanoVG::FontId font;
+        float size;
+        int align;
+        Rectangle<float> bounds;
+    };
+
+    std::vector<Entry> entries;
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "Base.hpp"
+#include <vector>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * groups many handler value changes, e.g. when loading a preset.
+ * between begin() and commit() the handlers' setValue and setDown only store the new value,
+ * repaints and callbacks are held back. commit() then repaints every changed widget once and,
+ * if asked for, sends one callback per handler with its final value.
+ * one transaction can be active at a time, UI thread only.
+*/
+class ValueTransaction
+{
+public:
+    // implemented by the handlers
+    struct Participant
+    {
+        // the transaction holding this participant until it is committed, nullptr if none
+        ValueTransaction *transaction;
+        bool transactionCallback;
+
+        Participant() noexcept;
+        virtual ~Participant();
+        virtual void commitTransaction(bool sendCallback) = 0;
+    };
+
+    ValueTransaction();
+
+    /*
+     * commits with callbacks if still active
+    */
+    ~ValueTransaction();
+
+    void begin();
+    uint commit(bool sendCallbacks = true);
+    bool isActive() const noexcept;
+
+    static ValueTransaction *getCurrent() noexcept;
+
+    /*
+     * used by the handlers, `sendCallback` as given to setValue
+    */
+    void add(Participant *participant, bool sendCallback);
+    void remove(Participant *participant) noexcept;
+
+private:
+    std::vector<Participant *> participants;
+    bool committing;
+
+    static ValueTransaction *current;
+
+    DISTRHO_DECLARE_NON_COPYABLE(ValueTransaction)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -0,0 +1,367 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+/*
+ * drives each event handler with a prebuilt stream of synthetic events and reports
+ * time, callbacks and repaints per event. usage: handler-benchmark [iterations]
+*/
+
+#include "Application.hpp"
+#include "TopLevelWidget.hpp"
+#include "SubWidget.hpp"
+#include "ExtraEventHandlers.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+USE_NAMESPACE_DGL;
+
+// --------------------------------------------------------------------------------------------------------------------
+
+namespace
+{
+
+class BenchWidget : public SubWidget
+{
+public:
+    explicit BenchWidget(Widget *const parent, const uint width, const uint height)
+        : SubWidget(parent)
+    {
+        setSize(width, height);
+    }
+
+protected:
+    void onDisplay() override {}
+};
+
+struct CallbackCounter : SwitchEventHandler::Callback,
+                         SliderEventHandler::Callback,
+                         SpinnerEventHandler::Callback,
+                         RadioEventHandler::Callback
+{
+    uint64_t count;
+
+    CallbackCounter() : count(0) {}
+
+    void switchClicked(SubWidget *, bool) override { ++count; }
+    void sliderDragStarted(SubWidget *) override { ++count; }
+    void sliderDragFinished(SubWidget *) override { ++count; }
+    void sliderValueChanged(SubWidget *, float) override { ++count; }
+    void spinnerValueChanged(SubWidget *, float) override { ++count; }
+    void radioValueChanged(SubWidget *, float) override { ++count; }
+};
+
+// one event of any kind, replayed in order
+struct Event
+{
+    enum Type
+    {
+        kMouse,
+        kMotion,
+        kScroll
+    } type;
+
+    Widget::MouseEvent mouse;
+    Widget::MotionEvent motion;
+    Widget::ScrollEvent scroll;
+};
+
+class EventStream
+{
+public:
+    EventStream() : time(0) {}
+
+    void press(const double x, const double y, const bool down, const uint mod = 0)
+    {
+        Event ev;
+        ev.type = Event::kMouse;
+        ev.mouse.button = 1;
+        ev.mouse.press = down;
+        ev.mouse.mod = mod;
+        ev.mouse.time = ++time;
+        ev.mouse.pos = Point<double>(x, y);
+        ev.mouse.absolutePos = ev.mouse.pos;
+        events.push_back(ev);
+    }
+
+    void click(const double x, const double y)
+    {
+        press(x, y, true);
+        press(x, y, false);
+    }
+
+    void motion(const double x, const double y)
+    {
+        Event ev;
+        ev.type = Event::kMotion;
+        ev.motion.time = ++time;
+        ev.motion.pos = Point<double>(x, y);
+        ev.motion.absolutePos = ev.motion.pos;
+        events.push_back(ev);
+    }
+
+    void scroll(const double x, const double y, const ScrollDirection direction)
+    {
+        Event ev;
+        ev.type = Event::kScroll;
+        ev.scroll.time = ++time;
+        ev.scroll.pos = Point<double>(x, y);
+        ev.scroll.absolutePos = ev.scroll.pos;
+        ev.scroll.direction = direction;
+        ev.scroll.delta = Point<double>(0.0, direction == kScrollUp ? 1.0 : -1.0);
+        events.push_back(ev);
+    }
+
+    // a drag along one axis: press at `from`, `steps` motion events to `to` and back, release
+    void drag(const bool horizontal, const double from, const double to, const uint steps)
+    {
+        press(horizontal ? from : 10.0, horizontal ? 10.0 : from, true);
+
+        for (uint i = 1; i <= steps; ++i)
+        {
+            const double p = from + (to - from) * (i <= steps / 2 ? i : steps - i) / (steps / 2);
+            motion(horizontal ? p : 10.0, horizontal ? 10.0 : p);
+        }
+
+        press(horizontal ? from : 10.0, horizontal ? 10.0 : from, false);
+    }
+
+    std::vector<Event> events;
+
+private:
+    uint time;
+};
+
+struct Harness
+{
+    Application app;
+    Window window;
+    TopLevelWidget topLevel;
+    CallbackCounter callbacks;
+
+    Harness()
+        : app(),
+          window(app),
+          topLevel(window)
+    {
+    }
+
+    void reset()
+    {
+        callbacks.count = 0;
+        window.widgetRepaints = 0;
+        window.areaRepaints = 0;
+    }
+};
+
+template <class Handler>
+bool dispatch(Handler &handler, const Event &ev)
+{
+    switch (ev.type)
+    {
+    case Event::kMouse:
+        return handler.mouseEvent(ev.mouse);
+    case Event::kMotion:
+        return handler.motionEvent(ev.motion);
+    case Event::kScroll:
+        return handler.scrollEvent(ev.scroll);
+    }
+
+    return false;
+}
+
+// the switch and radio handlers only take mouse events
+bool dispatch(SwitchEventHandler &handler, const Event &ev)
+{
+    return ev.type == Event::kMouse && handler.mouseEvent(ev.mouse);
+}
+
+bool dispatch(RadioEventHandler &handler, const Event &ev)
+{
+    return ev.type == Event::kMouse && handler.mouseEvent(ev.mouse);
+}
+
+void flush(SwitchEventHandler &) {}
+void flush(SpinnerEventHandler &) {}
+void flush(RadioEventHandler &) {}
+
+void flush(SliderEventHandler &handler)
+{
+    handler.flushMotion();
+}
+
+template <class Handler>
+void run(Harness &harness, const char *const name, Handler &handler, const EventStream &stream, const uint iterations)
+{
+    // warm up caches and let the handler settle into its steady state
+    for (const Event &ev : stream.events)
+        dispatch(handler, ev);
+    flush(handler);
+
+    harness.reset();
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (uint i = 0; i < iterations; ++i)
+    {
+        for (const Event &ev : stream.events)
+            dispatch(handler, ev);
+        flush(handler);
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+
+    const double events = double(stream.events.size()) * iterations;
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+    std::printf("%-24s %12.1f %12.3f %12.3f %12.3f\n",
+                name,
+                ns / events,
+                harness.callbacks.count / events,
+                harness.window.widgetRepaints / events,
+                harness.window.areaRepaints / events);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+void benchSwitch(Harness &harness, const uint iterations)
+{
+    BenchWidget widget(&harness.topLevel, 40, 40);
+    SwitchEventHandler handler(&widget);
+    handler.setCallback(&harness.callbacks);
+
+    EventStream stream;
+    for (uint i = 0; i < 100; ++i)
+        stream.click(20.0, 20.0);
+
+    run(harness, "switch click", handler, stream, iterations);
+}
+
+void benchSlider(Harness &harness, const uint iterations, const char *const name, const bool horizontal,
+                 const bool inverted, const bool logScale, const float step, const uint coalescing)
+{
+    BenchWidget widget(&harness.topLevel, horizontal ? 200 : 20, horizontal ? 20 : 200);
+    SliderEventHandler handler(&widget);
+    handler.setCallback(&harness.callbacks);
+    handler.setStartPos(0, 0);
+    handler.setEndPos(horizontal ? 200 : 0, horizontal ? 0 : 200);
+    handler.setSliderArea(0, 0, widget.getWidth(), widget.getHeight());
+    handler.setInverted(inverted);
+
+    if (logScale)
+    {
+        handler.setRange(20.0f, 20000.0f);
+        handler.setUsingLogScale(true);
+    }
+    else
+    {
+        handler.setRange(0.0f, 10.0f);
+    }
+
+    handler.setStep(step);
+    handler.setMotionCoalescing(coalescing);
+
+    EventStream stream;
+    stream.drag(horizontal, 0.0, 199.0, 200);
+
+    run(harness, name, handler, stream, iterations);
+}
+
+void benchSpinner(Harness &harness, const uint iterations)
+{
+    BenchWidget widget(&harness.topLevel, 20, 40);
+    SpinnerEventHandler handler(&widget);
+    handler.setCallback(&harness.callbacks);
+    handler.setIncrementArea(0, 0, 20, 20);
+    handler.setDecrementArea(0, 20, 20, 20);
+    handler.setRange(0.0f, 100.0f);
+    handler.setStep(1.0f);
+
+    EventStream clicks;
+    for (uint i = 0; i < 50; ++i)
+        clicks.click(10.0, 10.0);
+    for (uint i = 0; i < 50; ++i)
+        clicks.click(10.0, 30.0);
+
+    run(harness, "spinner click", handler, clicks, iterations);
+
+    EventStream scrolls;
+    for (uint i = 0; i < 100; ++i)
+        scrolls.scroll(10.0, 20.0, kScrollUp);
+    for (uint i = 0; i < 100; ++i)
+        scrolls.scroll(10.0, 20.0, kScrollDown);
+
+    run(harness, "spinner scroll", handler, scrolls, iterations);
+}
+
+void benchRadio(Harness &harness, const uint iterations, const char *const name, const RadioEventHandler::Layout layout)
+{
+    static const uint kOptions = 8;
+
+    BenchWidget widget(&harness.topLevel, 160, 160);
+    RadioEventHandler handler(&widget);
+    handler.setCallback(&harness.callbacks);
+
+    for (uint i = 0; i < kOptions; ++i)
+        handler.addOption("option", float(i));
+
+    if (layout == RadioEventHandler::kLayoutCustom)
+    {
+        handler.setLayout(layout);
+        for (uint i = 0; i < kOptions; ++i)
+            handler.setOptionHitbox(i, Rectangle<double>(0.0, i * 20.0, 160.0, 20.0));
+    }
+    else
+    {
+        handler.setLayout(layout, layout == RadioEventHandler::kLayoutGrid ? 4 : 1);
+    }
+
+    // click every option in turn, cells are found by position so any layout covers the widget
+    EventStream stream;
+    for (uint i = 0; i < 100; ++i)
+    {
+        const uint option = i % kOptions;
+
+        if (layout == RadioEventHandler::kLayoutGrid)
+            stream.click(20.0 + (option % 4) * 40.0, 40.0 + (option / 4) * 80.0);
+        else
+            stream.click(80.0, 10.0 + option * 20.0);
+    }
+
+    run(harness, name, handler, stream, iterations);
+}
+
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    const uint iterations = argc > 1 ? uint(std::max(1, std::atoi(argv[1]))) : 1000;
+
+    Harness harness;
+
+    std::printf("%-24s %12s %12s %12s %12s\n", "case", "ns/event", "callbacks", "repaints", "area rep.");
+
+    benchSwitch(harness, iterations);
+
+    benchSlider(harness, iterations, "slider horizontal", true, false, false, 0.0f, 0);
+    benchSlider(harness, iterations, "slider vertical", false, false, false, 0.0f, 0);
+    benchSlider(harness, iterations, "slider inverted", true, true, false, 0.0f, 0);
+    benchSlider(harness, iterations, "slider log", true, false, true, 0.0f, 0);
+    benchSlider(harness, iterations, "slider stepped", true, false, false, 0.1f, 0);
+    benchSlider(harness, iterations, "slider coalesced", true, false, false, 0.0f, 16);
+
+    benchSpinner(harness, iterations);
+
+    benchRadio(harness, iterations, "radio column", RadioEventHandler::kLayoutColumn);
+    benchRadio(harness, iterations, "radio grid", RadioEventHandler::kLayoutGrid);
+    benchRadio(harness, iterations, "radio custom", RadioEventHandler::kLayoutCustom);
+
+    return 0;
+}
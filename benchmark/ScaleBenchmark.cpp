@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+/*
+ * constructs and destroys thousands of each widget type and reports time, heap and resident memory
+ * per widget, then the size of each handler's private data. usage: scale-benchmark [count]
+*/
+
+#include "Application.hpp"
+#include "TopLevelWidget.hpp"
+#include "HandlerArena.hpp"
+#include "NanoButton.hpp"
+#include "NanoKnob.hpp"
+#include "NanoRadio.hpp"
+#include "NanoSlider.hpp"
+#include "NanoSpinner.hpp"
+#include "NanoSwitch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#ifdef __GLIBC__
+# include <malloc.h>
+#endif
+#include <unistd.h>
+
+// --------------------------------------------------------------------------------------------------------------------
+// every heap allocation is counted, this program is single threaded
+
+static uint64_t heapBytes = 0;
+static uint64_t heapAllocations = 0;
+
+void *operator new(const std::size_t size)
+{
+    heapBytes += size;
+    ++heapAllocations;
+
+    if (void *const ptr = std::malloc(size != 0 ? size : 1))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *const ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *const ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+USE_NAMESPACE_DGL;
+
+// --------------------------------------------------------------------------------------------------------------------
+
+namespace
+{
+
+class BenchWidget : public SubWidget
+{
+public:
+    explicit BenchWidget(Widget *const parent)
+        : SubWidget(parent)
+    {
+    }
+
+protected:
+    void onDisplay() override {}
+};
+
+// the widgets leave drawing to the plugin
+template <class W>
+class Concrete : public W
+{
+public:
+    template <class Callback>
+    explicit Concrete(Widget *const parent, Callback *const cb)
+        : W(parent, cb)
+    {
+    }
+
+protected:
+    void onNanoDisplay() override {}
+};
+
+double getResidentBytes()
+{
+    long pages = 0, resident = 0;
+
+    if (FILE *const f = std::fopen("/proc/self/statm", "r"))
+    {
+        if (std::fscanf(f, "%ld %ld", &pages, &resident) != 2)
+            resident = 0;
+        std::fclose(f);
+    }
+
+    return double(resident) * double(sysconf(_SC_PAGESIZE));
+}
+
+void releaseFreeMemory()
+{
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+}
+
+double elapsedNs(const std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <class W, class Callback>
+void benchWidget(TopLevelWidget &parent, const char *const name, const uint count)
+{
+    std::vector<Concrete<W> *> widgets;
+    widgets.reserve(count);
+
+    releaseFreeMemory();
+
+    const double rssBefore = getResidentBytes();
+    const uint64_t bytesBefore = heapBytes;
+    const uint64_t allocationsBefore = heapAllocations;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint i = 0; i < count; ++i)
+        widgets.push_back(new Concrete<W>(&parent, static_cast<Callback *>(nullptr)));
+
+    const double constructNs = elapsedNs(start);
+    const double rssAfter = getResidentBytes();
+    const uint64_t bytes = heapBytes - bytesBefore;
+    const uint64_t allocations = heapAllocations - allocationsBefore;
+
+    start = std::chrono::steady_clock::now();
+
+    // newest first, the way a UI tears down its members. each one unlinks itself from the parent's
+    // child list, which is a linear search in DGL as here, so this grows with `count`
+    for (uint i = count; i-- > 0;)
+        delete widgets[i];
+
+    const double destructNs = elapsedNs(start);
+
+    std::printf("%-14s %7zu %12.1f %12.1f %10.1f %8.2f %10.1f\n",
+                name,
+                sizeof(Concrete<W>),
+                constructNs / count,
+                destructNs / count,
+                double(bytes) / count,
+                double(allocations) / count,
+                std::max(0.0, rssAfter - rssBefore) / count);
+}
+
+template <class Handler>
+void benchHandler(TopLevelWidget &parent, const char *const name)
+{
+    BenchWidget widget(&parent);
+
+    // alone in an arena the handler takes exactly its aligned private data plus the arena header
+    HandlerArena arena;
+    std::size_t arenaBytes;
+    {
+        const HandlerArena::Scope scope(arena);
+        Handler handler(&widget);
+        arenaBytes = arena.getBytesUsed();
+    }
+
+    const uint64_t bytesBefore = heapBytes;
+    const uint64_t allocationsBefore = heapAllocations;
+    uint64_t bytes, allocations;
+    {
+        Handler handler(&widget);
+        bytes = heapBytes - bytesBefore;
+        allocations = heapAllocations - allocationsBefore;
+    }
+
+    std::printf("%-14s %7zu %12zu %10llu %8llu\n",
+                name,
+                sizeof(Handler),
+                arenaBytes,
+                static_cast<unsigned long long>(bytes),
+                static_cast<unsigned long long>(allocations));
+}
+
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    const uint count = argc > 1 ? uint(std::max(1, std::atoi(argv[1]))) : 5000;
+
+    Application app;
+    Window window(app);
+    TopLevelWidget topLevel(window);
+
+    std::printf("%u widgets of each type\n\n", count);
+    std::printf("%-14s %7s %12s %12s %10s %8s %10s\n",
+                "widget", "sizeof", "ctor ns", "dtor ns", "heap B", "allocs", "rss B");
+
+    benchWidget<NanoSwitch, SwitchEventHandler::Callback>(topLevel, "NanoSwitch", count);
+    benchWidget<NanoButton, ButtonEventHandler::Callback>(topLevel, "NanoButton", count);
+    benchWidget<NanoKnob, KnobEventHandler::Callback>(topLevel, "NanoKnob", count);
+    benchWidget<NanoSlider, SliderEventHandler::Callback>(topLevel, "NanoSlider", count);
+    benchWidget<NanoSpinner, SpinnerEventHandler::Callback>(topLevel, "NanoSpinner", count);
+    benchWidget<NanoRadio, RadioEventHandler::Callback>(topLevel, "NanoRadio", count);
+
+    std::printf("\n%-14s %7s %12s %10s %8s\n", "handler", "sizeof", "arena B", "heap B", "allocs");
+
+    benchHandler<SwitchEventHandler>(topLevel, "switch");
+    benchHandler<SliderEventHandler>(topLevel, "slider");
+    benchHandler<SpinnerEventHandler>(topLevel, "spinner");
+    benchHandler<RadioEventHandler>(topLevel, "radio");
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+/*
+ * headless stand-in for the parts of DPF's DGL the widgets use, only meant for the benchmarks.
+ * declarations follow DPF, anything marked "stand-in only" does not exist there.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+typedef unsigned char uchar;
+typedef unsigned int uint;
+
+#define START_NAMESPACE_DISTRHO namespace DISTRHO {
+#define END_NAMESPACE_DISTRHO }
+
+#define DGL_NAMESPACE DGL
+#define START_NAMESPACE_DGL namespace DGL_NAMESPACE {
+#define END_NAMESPACE_DGL }
+#define USE_NAMESPACE_DGL using namespace DGL_NAMESPACE;
+
+static inline void d_safe_assert(const char *const assertion, const char *const file, const int line) noexcept
+{
+    std::fprintf(stderr, "assertion failure: \"%s\" in file %s, line %i\n", assertion, file, line);
+}
+
+static inline void d_safe_exception(const char *const exception, const char *const file, const int line) noexcept
+{
+    std::fprintf(stderr, "exception caught: \"%s\" in file %s, line %i\n", exception, file, line);
+}
+
+#define DISTRHO_SAFE_ASSERT(cond) if (!(cond)) d_safe_assert(#cond, __FILE__, __LINE__);
+#define DISTRHO_SAFE_ASSERT_BREAK(cond) if (!(cond)) { d_safe_assert(#cond, __FILE__, __LINE__); break; }
+#define DISTRHO_SAFE_ASSERT_CONTINUE(cond) if (!(cond)) { d_safe_assert(#cond, __FILE__, __LINE__); continue; }
+#define DISTRHO_SAFE_ASSERT_RETURN(cond, ret) if (!(cond)) { d_safe_assert(#cond, __FILE__, __LINE__); return ret; }
+#define DISTRHO_SAFE_EXCEPTION(msg) catch (...) { d_safe_exception(msg, __FILE__, __LINE__); }
+
+#define DISTRHO_DECLARE_NON_COPYABLE(ClassName) \
+private:                                        \
+    ClassName(ClassName &) = delete;            \
+    ClassName(const ClassName &) = delete;      \
+    ClassName &operator=(ClassName &) = delete; \
+    ClassName &operator=(const ClassName &) = delete;
+
+#define DISTRHO_LEAK_DETECTOR(ClassName)
+
+template <typename T>
+static inline bool d_isEqual(const T &v1, const T &v2)
+{
+    return std::abs(v1 - v2) < std::numeric_limits<T>::epsilon();
+}
+
+template <typename T>
+static inline bool d_isNotEqual(const T &v1, const T &v2)
+{
+    return std::abs(v1 - v2) >= std::numeric_limits<T>::epsilon();
+}
+
+template <typename T>
+static inline bool d_isZero(const T &value)
+{
+    return std::abs(value) < std::numeric_limits<T>::epsilon();
+}
+
+template <typename T>
+static inline bool d_isNotZero(const T &value)
+{
+    return std::abs(value) >= std::numeric_limits<T>::epsilon();
+}
+
+START_NAMESPACE_DGL
+
+enum Modifier
+{
+    kModifierShift = 1u << 0u,
+    kModifierControl = 1u << 1u,
+    kModifierAlt = 1u << 2u,
+    kModifierSuper = 1u << 3u
+};
+
+enum ScrollDirection
+{
+    kScrollUp,
+    kScrollDown,
+    kScrollLeft,
+    kScrollRight,
+    kScrollSmooth
+};
+
+struct IdleCallback
+{
+    virtual ~IdleCallback() {}
+    virtual void idleCallback() = 0;
+};
+
+END_NAMESPACE_DGL
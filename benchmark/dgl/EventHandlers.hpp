@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "SubWidget.hpp"
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * reduced versions of DPF's own handlers, enough to construct and drive NanoButton and NanoKnob
+*/
+class ButtonEventHandler
+{
+public:
+    class Callback
+    {
+    public:
+        virtual ~Callback() {}
+        virtual void buttonClicked(SubWidget *widget, int button) = 0;
+    };
+
+    explicit ButtonEventHandler(SubWidget *self);
+    virtual ~ButtonEventHandler();
+
+    bool isButtonDown() const noexcept;
+    void setCallback(Callback *callback) noexcept;
+
+    bool mouseEvent(const Widget::MouseEvent &ev);
+    bool motionEvent(const Widget::MotionEvent &ev);
+
+private:
+    SubWidget *const widget;
+    Callback *callback;
+    int button;
+
+    DISTRHO_DECLARE_NON_COPYABLE(ButtonEventHandler)
+};
+
+class KnobEventHandler
+{
+public:
+    enum Orientation
+    {
+        Horizontal,
+        Vertical
+    };
+
+    class Callback
+    {
+    public:
+        virtual ~Callback() {}
+        virtual void knobDragStarted(SubWidget *widget) = 0;
+        virtual void knobDragFinished(SubWidget *widget) = 0;
+        virtual void knobValueChanged(SubWidget *widget, float value) = 0;
+    };
+
+    explicit KnobEventHandler(SubWidget *self);
+    virtual ~KnobEventHandler();
+
+    float getValue() const noexcept;
+    virtual bool setValue(float value, bool sendCallback = false) noexcept;
+    float getNormalizedValue() const noexcept;
+    void setRange(float min, float max) noexcept;
+    void setCallback(Callback *callback) noexcept;
+
+    bool mouseEvent(const Widget::MouseEvent &ev);
+    bool motionEvent(const Widget::MotionEvent &ev);
+    bool scrollEvent(const Widget::ScrollEvent &ev);
+
+private:
+    SubWidget *const widget;
+    Callback *callback;
+    float minimum;
+    float maximum;
+    float value;
+    bool dragging;
+    double lastY;
+
+    DISTRHO_DECLARE_NON_COPYABLE(KnobEventHandler)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
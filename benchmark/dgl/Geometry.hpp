@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "Base.hpp"
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+class Point
+{
+public:
+    Point() noexcept : x(0), y(0) {}
+    Point(const T &px, const T &py) noexcept : x(px), y(py) {}
+
+    const T &getX() const noexcept { return x; }
+    const T &getY() const noexcept { return y; }
+    void setX(const T &px) noexcept { x = px; }
+    void setY(const T &py) noexcept { y = py; }
+    void setPos(const T &px, const T &py) noexcept { x = px; y = py; }
+    void moveBy(const T &dx, const T &dy) noexcept { x += dx; y += dy; }
+    bool isZero() const noexcept { return x == 0 && y == 0; }
+
+    Point<T> operator+(const Point<T> &pos) noexcept { return Point<T>(x + pos.x, y + pos.y); }
+    Point<T> operator-(const Point<T> &pos) noexcept { return Point<T>(x - pos.x, y - pos.y); }
+    bool operator==(const Point<T> &pos) const noexcept { return x == pos.x && y == pos.y; }
+    bool operator!=(const Point<T> &pos) const noexcept { return !operator==(pos); }
+
+private:
+    T x, y;
+};
+
+template <typename T>
+class Size
+{
+public:
+    Size() noexcept : width(0), height(0) {}
+    Size(const T &w, const T &h) noexcept : width(w), height(h) {}
+
+    const T &getWidth() const noexcept { return width; }
+    const T &getHeight() const noexcept { return height; }
+    void setWidth(const T &w) noexcept { width = w; }
+    void setHeight(const T &h) noexcept { height = h; }
+    bool isNull() const noexcept { return width == 0 && height == 0; }
+    bool isValid() const noexcept { return width > 1 && height > 1; }
+
+    bool operator==(const Size<T> &size) const noexcept { return width == size.width && height == size.height; }
+    bool operator!=(const Size<T> &size) const noexcept { return !operator==(size); }
+
+private:
+    T width, height;
+};
+
+template <typename T>
+class Rectangle
+{
+public:
+    Rectangle() noexcept : pos(), size() {}
+    Rectangle(const T &x, const T &y, const T &w, const T &h) noexcept : pos(x, y), size(w, h) {}
+    Rectangle(const Point<T> &p, const Size<T> &s) noexcept : pos(p), size(s) {}
+
+    const T &getX() const noexcept { return pos.getX(); }
+    const T &getY() const noexcept { return pos.getY(); }
+    const T &getWidth() const noexcept { return size.getWidth(); }
+    const T &getHeight() const noexcept { return size.getHeight(); }
+    const Point<T> &getPos() const noexcept { return pos; }
+    const Size<T> &getSize() const noexcept { return size; }
+
+    void setX(const T &x) noexcept { pos.setX(x); }
+    void setY(const T &y) noexcept { pos.setY(y); }
+    void setWidth(const T &w) noexcept { size.setWidth(w); }
+    void setHeight(const T &h) noexcept { size.setHeight(h); }
+    void setRectangle(const Point<T> &p, const Size<T> &s) noexcept { pos = p; size = s; }
+
+    bool contains(const T &x, const T &y) const noexcept { return containsX(x) && containsY(y); }
+
+    template <typename T2>
+    bool contains(const Point<T2> &p) const noexcept { return contains(T(p.getX()), T(p.getY())); }
+
+    bool containsX(const T &x) const noexcept { return x >= pos.getX() && x <= pos.getX() + size.getWidth(); }
+    bool containsY(const T &y) const noexcept { return y >= pos.getY() && y <= pos.getY() + size.getHeight(); }
+    bool isNull() const noexcept { return size.isNull(); }
+    bool isValid() const noexcept { return size.isValid(); }
+
+    bool operator==(const Rectangle<T> &r) const noexcept { return pos == r.pos && size == r.size; }
+    bool operator!=(const Rectangle<T> &r) const noexcept { return !operator==(r); }
+
+private:
+    Point<T> pos;
+    Size<T> size;
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+struct Color
+{
+    float red, green, blue, alpha;
+
+    Color() noexcept : red(0.0f), green(0.0f), blue(0.0f), alpha(1.0f) {}
+    Color(const int r, const int g, const int b, const int a = 255) noexcept
+        : red(r / 255.0f), green(g / 255.0f), blue(b / 255.0f), alpha(a / 255.0f) {}
+    Color(const float r, const float g, const float b, const float a = 1.0f) noexcept
+        : red(r), green(g), blue(b), alpha(a) {}
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
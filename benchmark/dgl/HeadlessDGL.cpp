@@ -0,0 +1,654 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#include "Application.hpp"
+#include "EventHandlers.hpp"
+#include "NanoVG.hpp"
+#include "SubWidget.hpp"
+#include "TopLevelWidget.hpp"
+
+#include <chrono>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+Application::Application()
+{
+}
+
+double Application::getTime() const
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Application::idle()
+{
+    // callbacks may remove themselves
+    const std::vector<IdleCallback *> callbacks(idleCallbacks);
+
+    for (IdleCallback *const callback : callbacks)
+        callback->idleCallback();
+}
+
+Window::Window(Application &application)
+    : widgetRepaints(0),
+      areaRepaints(0),
+      app(application)
+{
+}
+
+Application &Window::getApp() const noexcept
+{
+    return app;
+}
+
+double Window::getScaleFactor() const noexcept
+{
+    return 1.0;
+}
+
+bool Window::addIdleCallback(IdleCallback *const callback, uint)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(callback != nullptr, false);
+
+    app.idleCallbacks.push_back(callback);
+    return true;
+}
+
+bool Window::removeIdleCallback(IdleCallback *const callback)
+{
+    std::vector<IdleCallback *> &callbacks(app.idleCallbacks);
+    const std::vector<IdleCallback *>::iterator it = std::find(callbacks.begin(), callbacks.end(), callback);
+
+    if (it == callbacks.end())
+        return false;
+
+    callbacks.erase(it);
+    return true;
+}
+
+void Window::repaint() noexcept
+{
+    ++widgetRepaints;
+}
+
+void Window::repaint(const Rectangle<uint> &) noexcept
+{
+    ++areaRepaints;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+Widget::Widget(TopLevelWidget *const topLevel)
+    : topLevelWidget(topLevel),
+      size(),
+      id(0),
+      visible(true)
+{
+}
+
+Widget::~Widget()
+{
+}
+
+bool Widget::isVisible() const noexcept
+{
+    return visible;
+}
+
+void Widget::setVisible(const bool yesNo)
+{
+    visible = yesNo;
+}
+
+void Widget::show()
+{
+    setVisible(true);
+}
+
+void Widget::hide()
+{
+    setVisible(false);
+}
+
+uint Widget::getWidth() const noexcept
+{
+    return size.getWidth();
+}
+
+uint Widget::getHeight() const noexcept
+{
+    return size.getHeight();
+}
+
+const Size<uint> Widget::getSize() const noexcept
+{
+    return size;
+}
+
+void Widget::setWidth(const uint width) noexcept
+{
+    setSize(width, size.getHeight());
+}
+
+void Widget::setHeight(const uint height) noexcept
+{
+    setSize(size.getWidth(), height);
+}
+
+void Widget::setSize(const uint width, const uint height) noexcept
+{
+    setSize(Size<uint>(width, height));
+}
+
+void Widget::setSize(const Size<uint> &newSize) noexcept
+{
+    if (size == newSize)
+        return;
+
+    ResizeEvent ev;
+    ev.oldSize = size;
+    ev.size = newSize;
+    size = newSize;
+    onResize(ev);
+}
+
+Application &Widget::getApp() const noexcept
+{
+    return getWindow().getApp();
+}
+
+Window &Widget::getWindow() const noexcept
+{
+    return topLevelWidget->getWindow();
+}
+
+TopLevelWidget *Widget::getTopLevelWidget() const noexcept
+{
+    return topLevelWidget;
+}
+
+std::list<SubWidget *> Widget::getChildren() const noexcept
+{
+    return children;
+}
+
+void Widget::repaint() noexcept
+{
+}
+
+uint Widget::getId() const noexcept
+{
+    return id;
+}
+
+void Widget::setId(const uint newId) noexcept
+{
+    id = newId;
+}
+
+bool Widget::onMouse(const MouseEvent &)
+{
+    return false;
+}
+
+bool Widget::onMotion(const MotionEvent &)
+{
+    return false;
+}
+
+bool Widget::onScroll(const ScrollEvent &)
+{
+    return false;
+}
+
+void Widget::onResize(const ResizeEvent &)
+{
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+SubWidget::SubWidget(Widget *const parent)
+    : Widget(parent->getTopLevelWidget()),
+      parentWidget(parent),
+      absolutePos()
+{
+    parent->children.push_back(this);
+}
+
+SubWidget::~SubWidget()
+{
+    parentWidget->children.remove(this);
+}
+
+int SubWidget::getAbsoluteX() const noexcept
+{
+    return absolutePos.getX();
+}
+
+int SubWidget::getAbsoluteY() const noexcept
+{
+    return absolutePos.getY();
+}
+
+Point<int> SubWidget::getAbsolutePos() const noexcept
+{
+    return absolutePos;
+}
+
+Rectangle<int> SubWidget::getAbsoluteArea() const noexcept
+{
+    return Rectangle<int>(absolutePos, Size<int>(static_cast<int>(getWidth()), static_cast<int>(getHeight())));
+}
+
+void SubWidget::setAbsoluteX(const int x) noexcept
+{
+    absolutePos.setX(x);
+}
+
+void SubWidget::setAbsoluteY(const int y) noexcept
+{
+    absolutePos.setY(y);
+}
+
+void SubWidget::setAbsolutePos(const int x, const int y) noexcept
+{
+    absolutePos.setPos(x, y);
+}
+
+void SubWidget::setAbsolutePos(const Point<int> &pos) noexcept
+{
+    absolutePos = pos;
+}
+
+Widget *SubWidget::getParentWidget() const noexcept
+{
+    return parentWidget;
+}
+
+void SubWidget::repaint() noexcept
+{
+    getWindow().repaint();
+}
+
+void SubWidget::toFront()
+{
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+TopLevelWidget::TopLevelWidget(Window &w)
+    : Widget(this),
+      window(w)
+{
+}
+
+TopLevelWidget::~TopLevelWidget()
+{
+}
+
+Window &TopLevelWidget::getWindow() const noexcept
+{
+    return window;
+}
+
+double TopLevelWidget::getScaleFactor() const noexcept
+{
+    return window.getScaleFactor();
+}
+
+void TopLevelWidget::repaint() noexcept
+{
+    window.repaint();
+}
+
+void TopLevelWidget::repaint(const Rectangle<uint> &rect) noexcept
+{
+    window.repaint(rect);
+}
+
+bool TopLevelWidget::addIdleCallback(IdleCallback *const callback, const uint timerFrequencyInMs)
+{
+    return window.addIdleCallback(callback, timerFrequencyInMs);
+}
+
+bool TopLevelWidget::removeIdleCallback(IdleCallback *const callback)
+{
+    return window.removeIdleCallback(callback);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+NanoImage::NanoImage()
+    : handle(0)
+{
+}
+
+NanoImage::NanoImage(const Handle &h)
+    : handle(h)
+{
+}
+
+NanoImage::~NanoImage()
+{
+}
+
+NanoImage &NanoImage::operator=(const Handle &h)
+{
+    handle = h;
+    return *this;
+}
+
+bool NanoImage::isValid() const noexcept
+{
+    return handle != 0;
+}
+
+Size<uint> NanoImage::getSize() const noexcept
+{
+    return Size<uint>();
+}
+
+NanoVG::Paint::Paint() noexcept
+    : radius(0.0f),
+      feather(0.0f),
+      innerColor(),
+      outerColor(),
+      imageId(0)
+{
+    std::memset(xform, 0, sizeof(xform));
+    std::memset(extent, 0, sizeof(extent));
+}
+
+NanoVG::NanoVG(int)
+    : currentFontSize(16.0f)
+{
+}
+
+NanoVG::~NanoVG()
+{
+}
+
+void NanoVG::save() {}
+void NanoVG::restore() {}
+void NanoVG::reset() {}
+void NanoVG::strokeColor(const Color &) {}
+void NanoVG::fillColor(const Color &) {}
+void NanoVG::strokePaint(const Paint &) {}
+void NanoVG::fillPaint(const Paint &) {}
+void NanoVG::strokeWidth(float) {}
+void NanoVG::lineCap(LineCap) {}
+void NanoVG::lineJoin(LineCap) {}
+void NanoVG::globalAlpha(float) {}
+void NanoVG::miterLimit(float) {}
+void NanoVG::resetTransform() {}
+void NanoVG::translate(float, float) {}
+void NanoVG::rotate(float) {}
+void NanoVG::scale(float, float) {}
+void NanoVG::scissor(float, float, float, float) {}
+void NanoVG::intersectScissor(float, float, float, float) {}
+void NanoVG::resetScissor() {}
+void NanoVG::beginPath() {}
+void NanoVG::moveTo(float, float) {}
+void NanoVG::lineTo(float, float) {}
+void NanoVG::bezierTo(float, float, float, float, float, float) {}
+void NanoVG::quadTo(float, float, float, float) {}
+void NanoVG::arcTo(float, float, float, float, float) {}
+void NanoVG::closePath() {}
+void NanoVG::pathWinding(Winding) {}
+void NanoVG::arc(float, float, float, float, float, Winding) {}
+void NanoVG::rect(float, float, float, float) {}
+void NanoVG::roundedRect(float, float, float, float, float) {}
+void NanoVG::ellipse(float, float, float, float) {}
+void NanoVG::circle(float, float, float) {}
+void NanoVG::fill() {}
+void NanoVG::stroke() {}
+
+NanoVG::Paint NanoVG::linearGradient(float, float, float, float, const Color &, const Color &)
+{
+    return Paint();
+}
+
+NanoVG::Paint NanoVG::boxGradient(float, float, float, float, float, float, const Color &, const Color &)
+{
+    return Paint();
+}
+
+NanoVG::Paint NanoVG::radialGradient(float, float, float, float, const Color &, const Color &)
+{
+    return Paint();
+}
+
+NanoVG::Paint NanoVG::imagePattern(float, float, float, float, float, const NanoImage &, float)
+{
+    return Paint();
+}
+
+NanoImage::Handle NanoVG::createImageFromFile(const char *, ImageFlags)
+{
+    return 0;
+}
+
+NanoImage::Handle NanoVG::createImageFromMemory(uchar *, uint, ImageFlags)
+{
+    return 0;
+}
+
+NanoVG::FontId NanoVG::createFontFromFile(const char *, const char *)
+{
+    return -1;
+}
+
+NanoVG::FontId NanoVG::findFont(const char *)
+{
+    return -1;
+}
+
+void NanoVG::fontSize(const float size)
+{
+    currentFontSize = size;
+}
+
+void NanoVG::fontBlur(float) {}
+void NanoVG::textLetterSpacing(float) {}
+void NanoVG::textLineHeight(float) {}
+void NanoVG::textAlign(Align) {}
+void NanoVG::textAlign(int) {}
+void NanoVG::fontFaceId(FontId) {}
+void NanoVG::fontFace(const char *) {}
+
+float NanoVG::text(const float x, float, const char *const string, const char *const end)
+{
+    const std::size_t length = end != nullptr ? static_cast<std::size_t>(end - string) : std::strlen(string);
+
+    return x + length * currentFontSize * 0.5f;
+}
+
+void NanoVG::textBox(float, float, float, const char *, const char *) {}
+
+float NanoVG::textBounds(const float x, const float y, const char *const string, const char *const end,
+                         Rectangle<float> &bounds)
+{
+    const float advance = text(x, y, string, end) - x;
+
+    bounds = Rectangle<float>(x, y - currentFontSize, advance, currentFontSize);
+    return advance;
+}
+
+void NanoVG::textMetrics(float *const ascender, float *const descender, float *const lineh)
+{
+    if (ascender != nullptr)
+        *ascender = currentFontSize * 0.8f;
+    if (descender != nullptr)
+        *descender = -currentFontSize * 0.2f;
+    if (lineh != nullptr)
+        *lineh = currentFontSize;
+}
+
+bool NanoVG::loadSharedResources()
+{
+    return true;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+ButtonEventHandler::ButtonEventHandler(SubWidget *const self)
+    : widget(self),
+      callback(nullptr),
+      button(-1)
+{
+}
+
+ButtonEventHandler::~ButtonEventHandler()
+{
+}
+
+bool ButtonEventHandler::isButtonDown() const noexcept
+{
+    return button != -1;
+}
+
+void ButtonEventHandler::setCallback(Callback *const cb) noexcept
+{
+    callback = cb;
+}
+
+bool ButtonEventHandler::mouseEvent(const Widget::MouseEvent &ev)
+{
+    if (ev.press)
+    {
+        if (!widget->contains(ev.pos))
+            return false;
+
+        button = static_cast<int>(ev.button);
+        widget->repaint();
+        return true;
+    }
+
+    if (button == -1)
+        return false;
+
+    const int clicked = button;
+    button = -1;
+    widget->repaint();
+
+    if (callback != nullptr && widget->contains(ev.pos))
+        callback->buttonClicked(widget, clicked);
+
+    return true;
+}
+
+bool ButtonEventHandler::motionEvent(const Widget::MotionEvent &)
+{
+    return false;
+}
+
+KnobEventHandler::KnobEventHandler(SubWidget *const self)
+    : widget(self),
+      callback(nullptr),
+      minimum(0.0f),
+      maximum(1.0f),
+      value(0.0f),
+      dragging(false),
+      lastY(0.0)
+{
+}
+
+KnobEventHandler::~KnobEventHandler()
+{
+}
+
+float KnobEventHandler::getValue() const noexcept
+{
+    return value;
+}
+
+bool KnobEventHandler::setValue(const float newValue, const bool sendCallback) noexcept
+{
+    const float clamped = std::max(minimum, std::min(newValue, maximum));
+
+    if (d_isEqual(value, clamped))
+        return false;
+
+    value = clamped;
+    widget->repaint();
+
+    if (sendCallback && callback != nullptr)
+        callback->knobValueChanged(widget, value);
+
+    return true;
+}
+
+float KnobEventHandler::getNormalizedValue() const noexcept
+{
+    return (value - minimum) / (maximum - minimum);
+}
+
+void KnobEventHandler::setRange(const float min, const float max) noexcept
+{
+    DISTRHO_SAFE_ASSERT_RETURN(max > min, );
+
+    minimum = min;
+    maximum = max;
+    value = std::max(minimum, std::min(value, maximum));
+}
+
+void KnobEventHandler::setCallback(Callback *const cb) noexcept
+{
+    callback = cb;
+}
+
+bool KnobEventHandler::mouseEvent(const Widget::MouseEvent &ev)
+{
+    if (ev.press)
+    {
+        if (!widget->contains(ev.pos))
+            return false;
+
+        dragging = true;
+        lastY = ev.pos.getY();
+
+        if (callback != nullptr)
+            callback->knobDragStarted(widget);
+
+        return true;
+    }
+
+    if (!dragging)
+        return false;
+
+    dragging = false;
+
+    if (callback != nullptr)
+        callback->knobDragFinished(widget);
+
+    return true;
+}
+
+bool KnobEventHandler::motionEvent(const Widget::MotionEvent &ev)
+{
+    if (!dragging)
+        return false;
+
+    const double movement = lastY - ev.pos.getY();
+    lastY = ev.pos.getY();
+
+    setValue(value + static_cast<float>(movement / 200.0) * (maximum - minimum), true);
+    return true;
+}
+
+bool KnobEventHandler::scrollEvent(const Widget::ScrollEvent &ev)
+{
+    if (!widget->contains(ev.pos))
+        return false;
+
+    setValue(value + static_cast<float>(ev.delta.getY() / 10.0) * (maximum - minimum), true);
+    return true;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
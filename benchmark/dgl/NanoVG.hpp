@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "SubWidget.hpp"
+#include "TopLevelWidget.hpp"
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+enum ImageFlags
+{
+    kImageNone = 0,
+    kImageGenerateMipmaps = 1
+};
+
+/*
+ * images are never created, every handle is invalid
+*/
+class NanoImage
+{
+public:
+    typedef int Handle;
+
+    NanoImage();
+    NanoImage(const Handle &handle);
+    ~NanoImage();
+
+    NanoImage &operator=(const Handle &handle);
+
+    bool isValid() const noexcept;
+    Size<uint> getSize() const noexcept;
+
+private:
+    Handle handle;
+};
+
+/*
+ * every drawing call is a no-op, text is measured with a fixed advance of half the font size
+*/
+class NanoVG
+{
+public:
+    enum CreateFlags
+    {
+        CREATE_ANTIALIAS = 1 << 0,
+        CREATE_STENCIL_STROKES = 1 << 1,
+        CREATE_DEBUG = 1 << 2
+    };
+
+    enum Align
+    {
+        ALIGN_LEFT = 1 << 0,
+        ALIGN_CENTER = 1 << 1,
+        ALIGN_RIGHT = 1 << 2,
+        ALIGN_TOP = 1 << 3,
+        ALIGN_MIDDLE = 1 << 4,
+        ALIGN_BOTTOM = 1 << 5,
+        ALIGN_BASELINE = 1 << 6
+    };
+
+    enum Winding
+    {
+        CCW = 1,
+        CW = 2
+    };
+
+    enum Solidity
+    {
+        SOLID = 1,
+        HOLE = 2
+    };
+
+    enum LineCap
+    {
+        BUTT,
+        ROUND,
+        SQUARE,
+        BEVEL,
+        MITER
+    };
+
+    typedef int FontId;
+
+    struct Paint
+    {
+        float xform[6];
+        float extent[2];
+        float radius;
+        float feather;
+        Color innerColor;
+        Color outerColor;
+        int imageId;
+
+        Paint() noexcept;
+    };
+
+    explicit NanoVG(int flags = CREATE_ANTIALIAS);
+    virtual ~NanoVG();
+
+    void save();
+    void restore();
+    void reset();
+
+    void strokeColor(const Color &color);
+    void fillColor(const Color &color);
+    void strokePaint(const Paint &paint);
+    void fillPaint(const Paint &paint);
+    void strokeWidth(float size);
+    void lineCap(LineCap cap = BUTT);
+    void lineJoin(LineCap join = MITER);
+    void globalAlpha(float alpha);
+    void miterLimit(float limit);
+
+    void resetTransform();
+    void translate(float x, float y);
+    void rotate(float angle);
+    void scale(float x, float y);
+
+    void scissor(float x, float y, float w, float h);
+    void intersectScissor(float x, float y, float w, float h);
+    void resetScissor();
+
+    void beginPath();
+    void moveTo(float x, float y);
+    void lineTo(float x, float y);
+    void bezierTo(float c1x, float c1y, float c2x, float c2y, float x, float y);
+    void quadTo(float cx, float cy, float x, float y);
+    void arcTo(float x1, float y1, float x2, float y2, float radius);
+    void closePath();
+    void pathWinding(Winding dir);
+    void arc(float cx, float cy, float r, float a0, float a1, Winding dir);
+    void rect(float x, float y, float w, float h);
+    void roundedRect(float x, float y, float w, float h, float r);
+    void ellipse(float cx, float cy, float rx, float ry);
+    void circle(float cx, float cy, float r);
+    void fill();
+    void stroke();
+
+    Paint linearGradient(float sx, float sy, float ex, float ey, const Color &icol, const Color &ocol);
+    Paint boxGradient(float x, float y, float w, float h, float r, float f, const Color &icol, const Color &ocol);
+    Paint radialGradient(float cx, float cy, float inr, float outr, const Color &icol, const Color &ocol);
+    Paint imagePattern(float ox, float oy, float ex, float ey, float angle, const NanoImage &image, float alpha);
+
+    NanoImage::Handle createImageFromFile(const char *filename, ImageFlags imageFlags);
+    NanoImage::Handle createImageFromMemory(uchar *data, uint dataSize, ImageFlags imageFlags);
+
+    FontId createFontFromFile(const char *name, const char *filename);
+    FontId findFont(const char *name);
+    void fontSize(float size);
+    void fontBlur(float blur);
+    void textLetterSpacing(float spacing);
+    void textLineHeight(float lineHeight);
+    void textAlign(Align align);
+    void textAlign(int align);
+    void fontFaceId(FontId font);
+    void fontFace(const char *font);
+    float text(float x, float y, const char *string, const char *end);
+    void textBox(float x, float y, float breakRowWidth, const char *string, const char *end = nullptr);
+    float textBounds(float x, float y, const char *string, const char *end, Rectangle<float> &bounds);
+    void textMetrics(float *ascender, float *descender, float *lineh);
+    bool loadSharedResources();
+
+private:
+    float currentFontSize;
+
+    DISTRHO_DECLARE_NON_COPYABLE(NanoVG)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+template <class BaseWidget>
+class NanoBaseWidget : public BaseWidget,
+                       public NanoVG
+{
+public:
+    explicit NanoBaseWidget(Widget *parentWidget, int flags = CREATE_ANTIALIAS)
+        : BaseWidget(parentWidget),
+          NanoVG(flags) {}
+
+    ~NanoBaseWidget() override {}
+
+protected:
+    virtual void onNanoDisplay() = 0;
+
+private:
+    void onDisplay() override
+    {
+        onNanoDisplay();
+    }
+};
+
+typedef NanoBaseWidget<SubWidget> NanoSubWidget;
+typedef NanoSubWidget NanoWidget;
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "Widget.hpp"
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+class SubWidget : public Widget
+{
+public:
+    explicit SubWidget(Widget *parentWidget);
+    ~SubWidget() override;
+
+    template <typename T>
+    bool contains(T x, T y) const noexcept
+    {
+        return x >= 0 && y >= 0 && static_cast<uint>(x) < getWidth() && static_cast<uint>(y) < getHeight();
+    }
+
+    template <typename T>
+    bool contains(const Point<T> &pos) const noexcept
+    {
+        return contains(pos.getX(), pos.getY());
+    }
+
+    int getAbsoluteX() const noexcept;
+    int getAbsoluteY() const noexcept;
+    Point<int> getAbsolutePos() const noexcept;
+    Rectangle<int> getAbsoluteArea() const noexcept;
+    void setAbsoluteX(int x) noexcept;
+    void setAbsoluteY(int y) noexcept;
+    void setAbsolutePos(int x, int y) noexcept;
+    void setAbsolutePos(const Point<int> &pos) noexcept;
+
+    Widget *getParentWidget() const noexcept;
+
+    void repaint() noexcept override;
+    void toFront();
+
+private:
+    Widget *const parentWidget;
+    Point<int> absolutePos;
+
+    DISTRHO_DECLARE_NON_COPYABLE(SubWidget)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "Widget.hpp"
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+class TopLevelWidget : public Widget
+{
+public:
+    explicit TopLevelWidget(Window &window);
+    ~TopLevelWidget() override;
+
+    Window &getWindow() const noexcept;
+    double getScaleFactor() const noexcept;
+
+    void repaint() noexcept override;
+    void repaint(const Rectangle<uint> &rect) noexcept;
+
+    bool addIdleCallback(IdleCallback *callback, uint timerFrequencyInMs = 0);
+    bool removeIdleCallback(IdleCallback *callback);
+
+protected:
+    void onDisplay() override {}
+
+private:
+    Window &window;
+
+    DISTRHO_DECLARE_NON_COPYABLE(TopLevelWidget)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "Geometry.hpp"
+#include <list>
+
+START_NAMESPACE_DGL
+
+class Application;
+class SubWidget;
+class TopLevelWidget;
+class Window;
+
+// --------------------------------------------------------------------------------------------------------------------
+
+class Widget
+{
+public:
+    struct BaseEvent
+    {
+        uint mod;
+        uint flags;
+        uint time;
+
+        BaseEvent() noexcept : mod(0), flags(0), time(0) {}
+        virtual ~BaseEvent() noexcept {}
+    };
+
+    struct MouseEvent : BaseEvent
+    {
+        uint button;
+        bool press;
+        Point<double> pos;
+        Point<double> absolutePos;
+
+        MouseEvent() noexcept : button(0), press(false) {}
+    };
+
+    struct MotionEvent : BaseEvent
+    {
+        Point<double> pos;
+        Point<double> absolutePos;
+    };
+
+    struct ScrollEvent : BaseEvent
+    {
+        Point<double> pos;
+        Point<double> absolutePos;
+        Point<double> delta;
+        ScrollDirection direction;
+
+        ScrollEvent() noexcept : direction(kScrollSmooth) {}
+    };
+
+    struct ResizeEvent
+    {
+        Size<uint> size;
+        Size<uint> oldSize;
+    };
+
+    explicit Widget(TopLevelWidget *topLevelWidget);
+    virtual ~Widget();
+
+    bool isVisible() const noexcept;
+    void setVisible(bool visible);
+    void show();
+    void hide();
+
+    uint getWidth() const noexcept;
+    uint getHeight() const noexcept;
+    const Size<uint> getSize() const noexcept;
+    void setWidth(uint width) noexcept;
+    void setHeight(uint height) noexcept;
+    void setSize(uint width, uint height) noexcept;
+    void setSize(const Size<uint> &size) noexcept;
+
+    Application &getApp() const noexcept;
+    Window &getWindow() const noexcept;
+    TopLevelWidget *getTopLevelWidget() const noexcept;
+    std::list<SubWidget *> getChildren() const noexcept;
+
+    virtual void repaint() noexcept;
+
+    uint getId() const noexcept;
+    void setId(uint id) noexcept;
+
+protected:
+    virtual void onDisplay() = 0;
+    virtual bool onMouse(const MouseEvent &ev);
+    virtual bool onMotion(const MotionEvent &ev);
+    virtual bool onScroll(const ScrollEvent &ev);
+    virtual void onResize(const ResizeEvent &ev);
+
+private:
+    TopLevelWidget *const topLevelWidget;
+    Size<uint> size;
+    uint id;
+    bool visible;
+
+    friend class SubWidget;
+    std::list<SubWidget *> children;
+
+    DISTRHO_DECLARE_NON_COPYABLE(Widget)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "Widget.hpp"
+#include <vector>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * no event loop and no display, idle callbacks only run from idle()
+*/
+class Application
+{
+public:
+    Application();
+
+    double getTime() const;
+    void idle();
+
+    // stand-in only
+    std::vector<IdleCallback *> idleCallbacks;
+
+    DISTRHO_DECLARE_NON_COPYABLE(Application)
+};
+
+/*
+ * repaints are only counted, nothing is ever drawn
+*/
+class Window
+{
+public:
+    explicit Window(Application &app);
+
+    Application &getApp() const noexcept;
+    double getScaleFactor() const noexcept;
+
+    bool addIdleCallback(IdleCallback *callback, uint timerFrequencyInMs = 0);
+    bool removeIdleCallback(IdleCallback *callback);
+
+    void repaint() noexcept;
+    void repaint(const Rectangle<uint> &rect) noexcept;
+
+    // stand-in only, whole widget repaints and repaints of an area within one
+    uint64_t widgetRepaints;
+    uint64_t areaRepaints;
+
+private:
+    Application &app;
+
+    DISTRHO_DECLARE_NON_COPYABLE(Window)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#include "AllocationAudit.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+static thread_local AllocationAudit::Scope *auditScope = nullptr;
+static thread_local bool auditReporting = false;
+
+static std::atomic<int> auditMode(AllocationAudit::kModeReport);
+static std::atomic<uint> auditViolations(0);
+
+// last violation, UI thread only in practice
+static AllocationAudit::Violation auditLastViolation = { nullptr, nullptr, 0, 0 };
+
+// --------------------------------------------------------------------------------------------------------------------
+
+AllocationAudit::Scope::Scope(const char *const s, const char *const f, const int l) noexcept
+    : site(s),
+      file(f),
+      line(l),
+      previous(auditScope)
+{
+    auditScope = this;
+}
+
+AllocationAudit::Scope::~Scope() noexcept
+{
+    auditScope = previous;
+}
+
+AllocationAudit::Suspend::Suspend() noexcept
+    : suspended(auditScope)
+{
+    auditScope = nullptr;
+}
+
+AllocationAudit::Suspend::~Suspend() noexcept
+{
+    auditScope = suspended;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+bool AllocationAudit::isEnabled() noexcept
+{
+#ifdef DGL_ALLOCATION_AUDIT
+    return true;
+#else
+    return false;
+#endif
+}
+
+void AllocationAudit::setMode(const Mode mode) noexcept
+{
+    auditMode.store(mode, std::memory_order_relaxed);
+}
+
+uint AllocationAudit::getNumViolations() noexcept
+{
+    return auditViolations.load(std::memory_order_relaxed);
+}
+
+bool AllocationAudit::getLastViolation(Violation &violation) noexcept
+{
+    if (auditLastViolation.site == nullptr)
+        return false;
+
+    violation = auditLastViolation;
+    return true;
+}
+
+void AllocationAudit::reset() noexcept
+{
+    auditViolations.store(0, std::memory_order_relaxed);
+    auditLastViolation.site = nullptr;
+}
+
+void AllocationAudit::checkAllocation(const std::size_t size) noexcept
+{
+    const Scope *const scope = auditScope;
+
+    // reporting itself may allocate, that must not recurse
+    if (scope == nullptr || auditReporting)
+        return;
+
+    auditReporting = true;
+    auditViolations.fetch_add(1, std::memory_order_relaxed);
+
+    auditLastViolation.site = scope->site;
+    auditLastViolation.file = scope->file;
+    auditLastViolation.line = scope->line;
+    auditLastViolation.size = size;
+
+    std::fprintf(stderr, "AllocationAudit: %zu bytes allocated in %s (%s:%d)\n",
+                 size, scope->site, scope->file, scope->line);
+
+    if (auditMode.load(std::memory_order_relaxed) == kModeAbort)
+        std::abort();
+
+    auditReporting = false;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+#ifdef DGL_ALLOCATION_AUDIT
+static void *auditedAllocate(const std::size_t size) noexcept
+{
+    DGL_NAMESPACE::AllocationAudit::checkAllocation(size);
+
+    return std::malloc(size != 0 ? size : 1);
+}
+
+void *operator new(const std::size_t size)
+{
+    if (void *const ptr = auditedAllocate(size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void *operator new[](const std::size_t size)
+{
+    if (void *const ptr = auditedAllocate(size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void *operator new(const std::size_t size, const std::nothrow_t &) noexcept
+{
+    return auditedAllocate(size);
+}
+
+void *operator new[](const std::size_t size, const std::nothrow_t &) noexcept
+{
+    return auditedAllocate(size);
+}
+
+void operator delete(void *const ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *const ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *const ptr, const std::nothrow_t &) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *const ptr, const std::nothrow_t &) noexcept
+{
+    std::free(ptr);
+}
+
+#if __cplusplus >= 201402L
+void operator delete(void *const ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *const ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+#endif
+#endif // DGL_ALLOCATION_AUDIT
+
+// --------------------------------------------------------------------------------------------------------------------
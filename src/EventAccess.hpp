@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "SubWidget.hpp"
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/*
+ * internal, calls the protected event functions of any widget.
+ * used by NanoWidgetPanel to forward events to its children and by EventReplayer
+*/
+struct EventAccess : SubWidget
+{
+    static bool mouse(SubWidget *const widget, const MouseEvent &ev)
+    {
+        return (widget->*&EventAccess::onMouse)(ev);
+    }
+
+    static bool motion(SubWidget *const widget, const MotionEvent &ev)
+    {
+        return (widget->*&EventAccess::onMotion)(ev);
+    }
+
+    static bool scroll(SubWidget *const widget, const ScrollEvent &ev)
+    {
+        return (widget->*&EventAccess::onScroll)(ev);
+    }
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
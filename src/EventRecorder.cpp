@@ -0,0 +1,398 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#include "EventRecorder.hpp"
+#include "EventAccess.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+static const uint32_t kRecordingMagic = 0x454c4744; // "DGLE"
+static const uint32_t kRecordingVersion = 1;
+static const size_t kRecordingHeaderSize = 2 * sizeof(uint32_t);
+
+// written to the file once this much is buffered
+static const size_t kRecordingBufferSize = 64 * 1024;
+
+enum RecordType
+{
+    kRecordMouse = 1,
+    kRecordMotion,
+    kRecordScroll
+};
+
+// type, widget, time, mod and the 2 positions, then the event specific fields
+static const size_t kRecordBaseSize = 1 + 2 + 4 + 4 + 4 * sizeof(float);
+static const size_t kRecordMouseSize = kRecordBaseSize + 2;
+static const size_t kRecordMotionSize = kRecordBaseSize;
+static const size_t kRecordScrollSize = kRecordBaseSize + 2 * sizeof(float) + 1;
+
+static size_t getRecordSize(const uint8_t type) noexcept
+{
+    switch (type)
+    {
+    case kRecordMouse:
+        return kRecordMouseSize;
+    case kRecordMotion:
+        return kRecordMotionSize;
+    case kRecordScroll:
+        return kRecordScrollSize;
+    }
+
+    return 0;
+}
+
+template <typename T>
+static inline uint8_t *put(uint8_t *const pos, const T value) noexcept
+{
+    std::memcpy(pos, &value, sizeof(T));
+    return pos + sizeof(T);
+}
+
+template <typename T>
+static inline const uint8_t *get(const uint8_t *const pos, T &value) noexcept
+{
+    std::memcpy(&value, pos, sizeof(T));
+    return pos + sizeof(T);
+}
+
+static inline uint8_t *putPoint(uint8_t *pos, const Point<double> &point) noexcept
+{
+    pos = put(pos, static_cast<float>(point.getX()));
+    return put(pos, static_cast<float>(point.getY()));
+}
+
+static inline const uint8_t *getPoint(const uint8_t *pos, Point<double> &point) noexcept
+{
+    float x, y;
+    pos = get(pos, x);
+    pos = get(pos, y);
+    point = Point<double>(x, y);
+    return pos;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+EventRecorder *EventRecorder::current = nullptr;
+
+EventRecorder::EventRecorder()
+    : file(nullptr),
+      numEvents(0)
+{
+}
+
+EventRecorder::~EventRecorder()
+{
+    stop();
+}
+
+uint EventRecorder::addWidget(SubWidget *const widget)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(widget != nullptr, 0);
+    DISTRHO_SAFE_ASSERT_RETURN(widgetIds.size() < 0xffff, 0);
+
+    const uint id = static_cast<uint>(widgetIds.size());
+    const WidgetId entry = { widget, id };
+
+    widgetIds.insert(std::lower_bound(widgetIds.begin(), widgetIds.end(), widget), entry);
+    return id;
+}
+
+bool EventRecorder::start(const char *const filename)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(filename != nullptr && filename[0] != '\0', false);
+    DISTRHO_SAFE_ASSERT_RETURN(current == nullptr, false);
+
+    file = std::fopen(filename, "wb");
+
+    if (file == nullptr)
+        return false;
+
+    buffer.reserve(kRecordingBufferSize + kRecordScrollSize);
+    buffer.resize(kRecordingHeaderSize);
+    put(put(buffer.data(), kRecordingMagic), kRecordingVersion);
+
+    numEvents = 0;
+    current = this;
+    return true;
+}
+
+void EventRecorder::stop()
+{
+    if (file == nullptr)
+        return;
+
+    if (current == this)
+        current = nullptr;
+
+    flush();
+    std::fclose(file);
+    file = nullptr;
+}
+
+bool EventRecorder::isRecording() const noexcept
+{
+    return file != nullptr;
+}
+
+uint EventRecorder::getNumEvents() const noexcept
+{
+    return numEvents;
+}
+
+int EventRecorder::findWidget(const SubWidget *const widget) const noexcept
+{
+    const auto it = std::lower_bound(widgetIds.begin(), widgetIds.end(), widget);
+
+    if (it == widgetIds.end() || it->widget != widget)
+        return -1;
+
+    return static_cast<int>(it->id);
+}
+
+uint8_t *EventRecorder::prepare(const SubWidget *const widget, const uint8_t type,
+                                const Widget::BaseEvent &ev, const size_t size)
+{
+    const int id = findWidget(widget);
+
+    if (id < 0)
+        return nullptr;
+
+    if (buffer.size() + size > kRecordingBufferSize)
+        flush();
+
+    const size_t offset = buffer.size();
+    buffer.resize(offset + size);
+    ++numEvents;
+
+    uint8_t *pos = buffer.data() + offset;
+    pos = put(pos, type);
+    pos = put(pos, static_cast<uint16_t>(id));
+    pos = put(pos, static_cast<uint32_t>(ev.time));
+    return put(pos, static_cast<uint32_t>(ev.mod));
+}
+
+void EventRecorder::writeMouse(const SubWidget *const widget, const Widget::MouseEvent &ev)
+{
+    uint8_t *pos = prepare(widget, kRecordMouse, ev, kRecordMouseSize);
+
+    if (pos == nullptr)
+        return;
+
+    pos = putPoint(pos, ev.pos);
+    pos = putPoint(pos, ev.absolutePos);
+    pos = put(pos, static_cast<uint8_t>(ev.button));
+    put(pos, static_cast<uint8_t>(ev.press ? 1 : 0));
+}
+
+void EventRecorder::writeMotion(const SubWidget *const widget, const Widget::MotionEvent &ev)
+{
+    uint8_t *pos = prepare(widget, kRecordMotion, ev, kRecordMotionSize);
+
+    if (pos == nullptr)
+        return;
+
+    pos = putPoint(pos, ev.pos);
+    putPoint(pos, ev.absolutePos);
+}
+
+void EventRecorder::writeScroll(const SubWidget *const widget, const Widget::ScrollEvent &ev)
+{
+    uint8_t *pos = prepare(widget, kRecordScroll, ev, kRecordScrollSize);
+
+    if (pos == nullptr)
+        return;
+
+    pos = putPoint(pos, ev.pos);
+    pos = putPoint(pos, ev.absolutePos);
+    pos = putPoint(pos, ev.delta);
+    put(pos, static_cast<uint8_t>(ev.direction));
+}
+
+void EventRecorder::flush()
+{
+    if (file == nullptr || buffer.empty())
+        return;
+
+    std::fwrite(buffer.data(), 1, buffer.size(), file);
+    buffer.clear();
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+EventReplayer::EventReplayer()
+    : numEvents(0),
+      lastReplayTime(0.0)
+{
+}
+
+uint EventReplayer::addWidget(SubWidget *const widget)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(widget != nullptr, 0);
+    DISTRHO_SAFE_ASSERT_RETURN(widgets.size() < 0xffff, 0);
+
+    widgets.push_back(widget);
+    return static_cast<uint>(widgets.size() - 1);
+}
+
+bool EventReplayer::load(const char *const filename)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(filename != nullptr && filename[0] != '\0', false);
+
+    data.clear();
+    numEvents = 0;
+
+    FILE *const file = std::fopen(filename, "rb");
+
+    if (file == nullptr)
+        return false;
+
+    uint8_t chunk[4096];
+    size_t read;
+
+    while ((read = std::fread(chunk, 1, sizeof(chunk), file)) != 0)
+        data.insert(data.end(), chunk, chunk + read);
+
+    std::fclose(file);
+
+    uint32_t magic = 0, version = 0;
+
+    if (data.size() < kRecordingHeaderSize)
+        return false;
+
+    get(get(data.data(), magic), version);
+
+    if (magic != kRecordingMagic || version != kRecordingVersion)
+        return false;
+
+    // check every record once, so replay() does not have to
+    uint count = 0;
+
+    for (size_t offset = kRecordingHeaderSize; offset < data.size(); ++count)
+    {
+        const size_t size = getRecordSize(data[offset]);
+
+        if (size == 0 || offset + size > data.size())
+            return false;
+
+        uint16_t id;
+        get(data.data() + offset + 1, id);
+
+        if (id >= widgets.size())
+            return false;
+
+        offset += size;
+    }
+
+    numEvents = count;
+    return true;
+}
+
+uint EventReplayer::getNumEvents() const noexcept
+{
+    return numEvents;
+}
+
+uint EventReplayer::replay(const Timing timing)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    uint consumed = 0;
+    uint32_t firstTime = 0;
+    Clock::duration spent = Clock::duration::zero();
+    const Clock::time_point start = Clock::now();
+
+    for (size_t offset = kRecordingHeaderSize; offset < data.size(); offset += getRecordSize(data[offset]))
+    {
+        const uint8_t type = data[offset];
+        const uint8_t *pos = data.data() + offset + 1;
+
+        uint16_t id;
+        uint32_t time, mod;
+        pos = get(pos, id);
+        pos = get(pos, time);
+        pos = get(pos, mod);
+
+        if (offset == kRecordingHeaderSize)
+            firstTime = time;
+        else if (timing == kTimingOriginal)
+            std::this_thread::sleep_until(start + std::chrono::milliseconds(time - firstTime));
+
+        SubWidget *const widget = widgets[id];
+        const Clock::time_point eventStart = Clock::now();
+        bool ret = false;
+
+        switch (type)
+        {
+        case kRecordMouse:
+        {
+            Widget::MouseEvent ev;
+            ev.time = time;
+            ev.mod = mod;
+            pos = getPoint(pos, ev.pos);
+            pos = getPoint(pos, ev.absolutePos);
+
+            uint8_t button, press;
+            pos = get(pos, button);
+            get(pos, press);
+            ev.button = button;
+            ev.press = press != 0;
+
+            ret = EventAccess::mouse(widget, ev);
+            break;
+        }
+        case kRecordMotion:
+        {
+            Widget::MotionEvent ev;
+            ev.time = time;
+            ev.mod = mod;
+            pos = getPoint(pos, ev.pos);
+            getPoint(pos, ev.absolutePos);
+
+            ret = EventAccess::motion(widget, ev);
+            break;
+        }
+        case kRecordScroll:
+        {
+            Widget::ScrollEvent ev;
+            ev.time = time;
+            ev.mod = mod;
+            pos = getPoint(pos, ev.pos);
+            pos = getPoint(pos, ev.absolutePos);
+            pos = getPoint(pos, ev.delta);
+
+            uint8_t direction;
+            get(pos, direction);
+            ev.direction = static_cast<ScrollDirection>(direction);
+
+            ret = EventAccess::scroll(widget, ev);
+            break;
+        }
+        }
+
+        spent += Clock::now() - eventStart;
+
+        if (ret)
+            ++consumed;
+    }
+
+    lastReplayTime = std::chrono::duration<double>(spent).count();
+    return consumed;
+}
+
+double EventReplayer::getLastReplayTime() const noexcept
+{
+    return lastReplayTime;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
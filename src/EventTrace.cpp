@@ -0,0 +1,332 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#include "EventTrace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+#ifdef DGL_EVENT_TRACE
+
+// a slot is valid when its sequence matches the write index it was claimed with, plus 1
+struct TraceSlot
+{
+    std::atomic<uint64_t> sequence;
+    std::atomic<uint64_t> time;
+    std::atomic<const void *> widget;
+    std::atomic<uint32_t> info;
+};
+
+static std::atomic<uint64_t> traceCounters[EventTrace::kHandlerCount][EventTrace::kPointCount];
+static std::atomic<uint64_t> traceWriteIndex;
+static TraceSlot traceRing[EventTrace::kRingSize];
+
+static inline uint64_t getTraceTime() noexcept
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// span of one event, from the event being received to the last callback or repaint it caused
+struct TraceSpan
+{
+    uint64_t start;
+    uint64_t callback;
+    uint64_t repaint;
+};
+
+static TraceSpan getSpan(const std::vector<EventTrace::Record> &records, const size_t start) noexcept
+{
+    const EventTrace::Record &first(records[start]);
+    TraceSpan span = { first.time, 0, 0 };
+
+    for (size_t i = start + 1; i < records.size(); ++i)
+    {
+        const EventTrace::Record &rec(records[i]);
+
+        if (rec.widget != first.widget)
+            continue;
+        if (rec.point == EventTrace::kPointEventReceived)
+            break;
+
+        if (rec.point == EventTrace::kPointCallbackFired)
+            span.callback = rec.time;
+        else if (rec.point == EventTrace::kPointRepaintRequested)
+            span.repaint = rec.time;
+    }
+
+    return span;
+}
+
+static std::vector<EventTrace::Record> getAllRecords()
+{
+    std::vector<EventTrace::Record> records(EventTrace::kRingSize);
+    records.resize(EventTrace::getRecords(records.data(), EventTrace::kRingSize));
+    return records;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+void EventTrace::record(const Handler handler, const Point point, const void *const widget) noexcept
+{
+    traceCounters[handler][point].fetch_add(1, std::memory_order_relaxed);
+
+    const uint64_t index = traceWriteIndex.fetch_add(1, std::memory_order_relaxed);
+    TraceSlot &slot(traceRing[index & (kRingSize - 1)]);
+
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.time.store(getTraceTime(), std::memory_order_relaxed);
+    slot.widget.store(widget, std::memory_order_relaxed);
+    slot.info.store(static_cast<uint32_t>(handler) << 8 | static_cast<uint32_t>(point), std::memory_order_relaxed);
+    slot.sequence.store(index + 1, std::memory_order_release);
+}
+
+uint64_t EventTrace::getCount(const Handler handler, const Point point) noexcept
+{
+    DISTRHO_SAFE_ASSERT_RETURN(handler < kHandlerCount && point < kPointCount, 0);
+
+    return traceCounters[handler][point].load(std::memory_order_relaxed);
+}
+
+uint EventTrace::getRecords(Record *const records, const uint maxRecords) noexcept
+{
+    DISTRHO_SAFE_ASSERT_RETURN(records != nullptr, 0);
+
+    const uint64_t end = traceWriteIndex.load(std::memory_order_acquire);
+    const uint64_t available = std::min<uint64_t>(end, std::min<uint64_t>(maxRecords, kRingSize));
+    uint count = 0;
+
+    for (uint64_t index = end - available; index < end; ++index)
+    {
+        const TraceSlot &slot(traceRing[index & (kRingSize - 1)]);
+
+        // skip slots that are being written, or were overwritten by a newer record
+        if (slot.sequence.load(std::memory_order_acquire) != index + 1)
+            continue;
+
+        Record &rec(records[count]);
+        rec.time = slot.time.load(std::memory_order_relaxed);
+        rec.widget = slot.widget.load(std::memory_order_relaxed);
+
+        const uint32_t info = slot.info.load(std::memory_order_relaxed);
+        rec.handler = static_cast<Handler>(info >> 8);
+        rec.point = static_cast<Point>(info & 0xff);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (slot.sequence.load(std::memory_order_relaxed) == index + 1)
+            ++count;
+    }
+
+    return count;
+}
+
+void EventTrace::reset() noexcept
+{
+    for (uint h = 0; h < kHandlerCount; ++h)
+        for (uint p = 0; p < kPointCount; ++p)
+            traceCounters[h][p].store(0, std::memory_order_relaxed);
+
+    for (uint i = 0; i < kRingSize; ++i)
+        traceRing[i].sequence.store(0, std::memory_order_relaxed);
+}
+
+bool EventTrace::writeChromeTrace(const char *const filename)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(filename != nullptr && filename[0] != '\0', false);
+
+    FILE *const file = std::fopen(filename, "w");
+
+    if (file == nullptr)
+        return false;
+
+    const std::vector<Record> records(getAllRecords());
+
+    std::fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+    for (uint h = 0; h < kHandlerCount; ++h)
+        std::fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}},\n",
+                     h + 1, getHandlerName(static_cast<Handler>(h)));
+
+    const uint64_t origin = records.empty() ? 0 : records.front().time;
+
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        const Record &rec(records[i]);
+        const double ts = static_cast<double>(rec.time - origin) / 1000.0;
+
+        std::fprintf(file, "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,"
+                           "\"args\":{\"widget\":\"%p\"}},\n",
+                     getPointName(rec.point), rec.handler + 1, ts, rec.widget);
+
+        if (rec.point != kPointEventReceived)
+            continue;
+
+        const TraceSpan span(getSpan(records, i));
+        const uint64_t end = std::max(span.callback, span.repaint);
+
+        if (end == 0)
+            continue;
+
+        std::fprintf(file, "{\"name\":\"%s event\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,"
+                           "\"args\":{\"widget\":\"%p\"}},\n",
+                     getHandlerName(rec.handler), rec.handler + 1, ts,
+                     static_cast<double>(end - span.start) / 1000.0, rec.widget);
+    }
+
+    // closing metadata entry, so every event above can end with a comma
+    std::fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"handlers\"}}\n]}\n");
+
+    return std::fclose(file) == 0;
+}
+
+void EventTrace::writeSummary(FILE *const file)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(file != nullptr, );
+
+    std::fprintf(file, "%-8s %10s %10s %10s %10s %10s\n",
+                 "handler", "received", "consumed", "changed", "callbacks", "repaints");
+
+    for (uint h = 0; h < kHandlerCount; ++h)
+    {
+        std::fprintf(file, "%-8s", getHandlerName(static_cast<Handler>(h)));
+
+        for (uint p = 0; p < kPointCount; ++p)
+            std::fprintf(file, " %10llu",
+                         static_cast<unsigned long long>(getCount(static_cast<Handler>(h), static_cast<Point>(p))));
+
+        std::fprintf(file, "\n");
+    }
+
+    // latencies over the records still in the ring
+    const std::vector<Record> records(getAllRecords());
+
+    uint64_t callbackTotal[kHandlerCount] = {}, callbackMax[kHandlerCount] = {};
+    uint64_t repaintTotal[kHandlerCount] = {}, repaintMax[kHandlerCount] = {};
+    uint callbackCount[kHandlerCount] = {}, repaintCount[kHandlerCount] = {};
+
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        if (records[i].point != kPointEventReceived)
+            continue;
+
+        const Handler h = records[i].handler;
+        const TraceSpan span(getSpan(records, i));
+
+        if (span.callback != 0)
+        {
+            const uint64_t latency = span.callback - span.start;
+            callbackTotal[h] += latency;
+            callbackMax[h] = std::max(callbackMax[h], latency);
+            ++callbackCount[h];
+        }
+
+        if (span.repaint != 0)
+        {
+            const uint64_t latency = span.repaint - span.start;
+            repaintTotal[h] += latency;
+            repaintMax[h] = std::max(repaintMax[h], latency);
+            ++repaintCount[h];
+        }
+    }
+
+    std::fprintf(file, "\n%-8s %14s %14s %14s %14s   (us, last %u records)\n",
+                 "handler", "callback avg", "callback max", "repaint avg", "repaint max",
+                 static_cast<uint>(records.size()));
+
+    for (uint h = 0; h < kHandlerCount; ++h)
+    {
+        std::fprintf(file, "%-8s %14.3f %14.3f %14.3f %14.3f\n",
+                     getHandlerName(static_cast<Handler>(h)),
+                     callbackCount[h] != 0 ? callbackTotal[h] / 1000.0 / callbackCount[h] : 0.0,
+                     callbackMax[h] / 1000.0,
+                     repaintCount[h] != 0 ? repaintTotal[h] / 1000.0 / repaintCount[h] : 0.0,
+                     repaintMax[h] / 1000.0);
+    }
+}
+
+#else // DGL_EVENT_TRACE
+
+// not built with tracing, keep the API linkable but compile out the ring and counters
+
+void EventTrace::record(Handler, Point, const void *) noexcept
+{
+}
+
+uint64_t EventTrace::getCount(Handler, Point) noexcept
+{
+    return 0;
+}
+
+uint EventTrace::getRecords(Record *, uint) noexcept
+{
+    return 0;
+}
+
+void EventTrace::reset() noexcept
+{
+}
+
+bool EventTrace::writeChromeTrace(const char *)
+{
+    return false;
+}
+
+void EventTrace::writeSummary(FILE *)
+{
+}
+
+#endif // DGL_EVENT_TRACE
+
+const char *EventTrace::getHandlerName(const Handler handler) noexcept
+{
+    switch (handler)
+    {
+    case kHandlerSwitch:
+        return "switch";
+    case kHandlerSlider:
+        return "slider";
+    case kHandlerSpinner:
+        return "spinner";
+    case kHandlerRadio:
+        return "radio";
+    case kHandlerCount:
+        break;
+    }
+
+    return "unknown";
+}
+
+const char *EventTrace::getPointName(const Point point) noexcept
+{
+    switch (point)
+    {
+    case kPointEventReceived:
+        return "event received";
+    case kPointEventConsumed:
+        return "event consumed";
+    case kPointValueChanged:
+        return "value changed";
+    case kPointCallbackFired:
+        return "callback fired";
+    case kPointRepaintRequested:
+        return "repaint requested";
+    case kPointCount:
+        break;
+    }
+
+    return "unknown";
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
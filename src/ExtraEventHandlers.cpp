@@ -5,24 +5,125 @@
 
 #include "ExtraEventHandlers.hpp"
 #include "SubWidget.hpp"
+#include "TopLevelWidget.hpp"
+#include "ParameterQueue.hpp"
+#include "HandlerArena.hpp"
+#include "RepaintScheduler.hpp"
+#include "ValueTransaction.hpp"
+#include "UndoJournal.hpp"
+#include "EventTrace.hpp"
+#include "AllocationAudit.hpp"
+
+#include <cmath>
 
 START_NAMESPACE_DGL
 
 // --------------------------------------------------------------------------------------------------------------------
 
-struct SwitchEventHandler::PrivateData
+static Rectangle<double> combineAreas(const Rectangle<double> &a, const Rectangle<double> &b)
+{
+    if (!a.isValid())
+        return b;
+    if (!b.isValid())
+        return a;
+
+    const double x1 = std::min(a.getX(), b.getX());
+    const double y1 = std::min(a.getY(), b.getY());
+    const double x2 = std::max(a.getX() + a.getWidth(), b.getX() + b.getWidth());
+    const double y2 = std::max(a.getY() + a.getHeight(), b.getY() + b.getHeight());
+
+    return Rectangle<double>(x1, y1, x2 - x1, y2 - y1);
+}
+
+void repaintWidgetArea(SubWidget *const widget, const Rectangle<double> &area)
+{
+    TopLevelWidget *const topLevelWidget = widget->getTopLevelWidget();
+
+    if (topLevelWidget == nullptr || !area.isValid())
+    {
+        widget->repaint();
+        return;
+    }
+
+    // expand to whole pixels, and stay within the widget
+    const double x1 = std::max(0.0, std::floor(area.getX()));
+    const double y1 = std::max(0.0, std::floor(area.getY()));
+    const double x2 = std::min(double(widget->getWidth()), std::ceil(area.getX() + area.getWidth()));
+    const double y2 = std::min(double(widget->getHeight()), std::ceil(area.getY() + area.getHeight()));
+
+    if (x2 <= x1 || y2 <= y1)
+        return;
+
+    topLevelWidget->repaint(Rectangle<uint>(static_cast<uint>(widget->getAbsoluteX() + x1),
+                                            static_cast<uint>(widget->getAbsoluteY() + y1),
+                                            static_cast<uint>(x2 - x1),
+                                            static_cast<uint>(y2 - y1)));
+}
+
+static inline void publishValue(ParameterQueue *const queue, const uint32_t parameter,
+                                const float value, const uint time) noexcept
+{
+    if (queue != nullptr)
+    {
+        DGL_AUDIT_SUSPEND();
+        queue->push(parameter, value, time);
+    }
+}
+
+static inline void requestRepaint(RepaintScheduler *const scheduler, SubWidget *const widget,
+                                  const EventTrace::Handler traceHandler)
 {
+    DGL_TRACE_POINT(traceHandler, kPointRepaintRequested, widget);
+
+    if (scheduler != nullptr)
+    {
+        DGL_AUDIT_SUSPEND();
+        scheduler->markDirty(widget);
+    }
+    else
+    {
+        widget->repaint();
+    }
+}
+
+// handler state comes from the current HandlerArena, if any
+struct PooledPrivateData
+{
+    static void *operator new(const std::size_t size)
+    {
+        return HandlerArena::allocateHandlerData(size);
+    }
+
+    static void operator delete(void *const ptr) noexcept
+    {
+        HandlerArena::releaseHandlerData(ptr);
+    }
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+struct SwitchEventHandler::PrivateData : PooledPrivateData,
+                                         ValueTransaction::Participant
+{
+    static const EventTrace::Handler kTraceHandler = EventTrace::kHandlerSwitch;
+
     SwitchEventHandler *const self;
     SubWidget *const widget;
     SwitchEventHandler::Callback *callback;
+    RepaintScheduler *scheduler;
+    UndoJournal *journal;
+    uint32_t journalId;
 
     bool isDown;
 
     PrivateData(SwitchEventHandler *const s, SubWidget *const w)
         : self(s),
           widget(w),
-          isDown(false),
-          callback(nullptr)
+          callback(nullptr),
+          scheduler(nullptr),
+          journal(nullptr),
+          journalId(0),
+          isDown(false)
     {
     }
 
@@ -30,6 +131,9 @@ struct SwitchEventHandler::PrivateData
         : self(s),
           widget(w),
           callback(other->callback),
+          scheduler(other->scheduler),
+          journal(other->journal),
+          journalId(other->journalId),
           isDown(other->isDown)
 
     {
@@ -38,6 +142,9 @@ struct SwitchEventHandler::PrivateData
     void assignFrom(PrivateData *const other)
     {
         callback = other->callback;
+        scheduler = other->scheduler;
+        journal = other->journal;
+        journalId = other->journalId;
         isDown = other->isDown;
     }
 
@@ -46,10 +153,17 @@ struct SwitchEventHandler::PrivateData
         if (ev.press && widget->contains(ev.pos))
         {
             isDown = !isDown;
-            widget->repaint();
+            DGL_TRACE_POINT(kTraceHandler, kPointValueChanged, widget);
+            requestRepaint(scheduler, widget, kTraceHandler);
+
+            if (journal != nullptr)
+                journal->record(journalId, isDown ? 0.0f : 1.0f, isDown ? 1.0f : 0.0f, ev.time);
 
             if (callback != nullptr)
             {
+                DGL_TRACE_POINT(kTraceHandler, kPointCallbackFired, widget);
+                DGL_AUDIT_SUSPEND();
+
                 try
                 {
                     callback->switchClicked(widget, isDown);
@@ -65,8 +179,27 @@ struct SwitchEventHandler::PrivateData
 
     void setDown(const bool down) noexcept
     {
+        const bool changed = isDown != down;
+
+        if (changed)
+            DGL_TRACE_POINT(kTraceHandler, kPointValueChanged, widget);
+
         isDown = down;
-        widget->repaint();
+
+        // only changed handlers join, so a transaction repaints just what changed
+        if (ValueTransaction *const transaction = ValueTransaction::getCurrent())
+        {
+            if (changed)
+                transaction->add(this, false);
+            return;
+        }
+
+        requestRepaint(scheduler, widget, kTraceHandler);
+    }
+
+    void commitTransaction(bool) override
+    {
+        requestRepaint(scheduler, widget, kTraceHandler);
     }
 };
 
@@ -86,9 +219,23 @@ SwitchEventHandler &SwitchEventHandler::operator=(const SwitchEventHandler &othe
 
 SwitchEventHandler::~SwitchEventHandler()
 {
+    if (pData->scheduler != nullptr)
+        pData->scheduler->cancel(pData->widget);
+
     delete pData;
 }
 
+void SwitchEventHandler::setRepaintScheduler(RepaintScheduler *const scheduler) noexcept
+{
+    pData->scheduler = scheduler;
+}
+
+void SwitchEventHandler::setUndoJournal(UndoJournal *const journal, const uint32_t id) noexcept
+{
+    pData->journal = journal;
+    pData->journalId = id;
+}
+
 void SwitchEventHandler::setCallback(Callback *const callback) noexcept
 {
     pData->callback = callback;
@@ -96,7 +243,15 @@ void SwitchEventHandler::setCallback(Callback *const callback) noexcept
 
 bool SwitchEventHandler::mouseEvent(const Widget::MouseEvent &ev)
 {
-    return pData->mouseEvent(ev);
+    DGL_AUDIT_ALLOCATIONS("SwitchEventHandler::mouseEvent");
+    DGL_TRACE_POINT(PrivateData::kTraceHandler, kPointEventReceived, pData->widget);
+
+    const bool consumed = pData->mouseEvent(ev);
+
+    if (consumed)
+        DGL_TRACE_POINT(PrivateData::kTraceHandler, kPointEventConsumed, pData->widget);
+
+    return consumed;
 }
 
 bool SwitchEventHandler::isDown() const noexcept
@@ -106,17 +261,38 @@ bool SwitchEventHandler::isDown() const noexcept
 
 void SwitchEventHandler::setDown(const bool down) noexcept
 {
+    DGL_AUDIT_ALLOCATIONS("SwitchEventHandler::setDown");
     return pData->setDown(down);
 }
 
+void SwitchEventHandler::saveState(Snapshot &state) const noexcept
+{
+    state.down = pData->isDown;
+}
+
+void SwitchEventHandler::restoreState(const Snapshot &state) noexcept
+{
+    pData->setDown(state.down);
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 
 // begin slider
-struct SliderEventHandler::PrivateData
+struct SliderEventHandler::PrivateData : PooledPrivateData,
+                                         ValueTransaction::Participant,
+                                         RepaintScheduler::AreaRepainter
 {
+    static const EventTrace::Handler kTraceHandler = EventTrace::kHandlerSlider;
+
     SliderEventHandler *const self;
     SubWidget *const widget;
     SliderEventHandler::Callback *callback;
+    RepaintScheduler *scheduler;
+    UndoJournal *journal;
+    uint32_t journalId;
+    ParameterQueue *queue;
+    uint32_t queueParameter;
+    uint eventTime;
 
     float minimum;
     float maximum;
@@ -129,16 +305,30 @@ struct SliderEventHandler::PrivateData
     bool dragging;
     bool inverted;
     bool valueIsSet;
+    bool quantizedRepaints;
+    float dragStartValue;
+    bool motionPending;
+    float motionValue;
+    uint motionInterval;
+    uint lastMotionTime;
     double startedX;
     double startedY;
     Point<int> startPos;
     Point<int> endPos;
     Rectangle<double> sliderArea;
+    Size<double> thumbSize;
+    ValueCurve curve;
 
     PrivateData(SliderEventHandler *const s, SubWidget *const w)
         : self(s),
           widget(w),
           callback(nullptr),
+          scheduler(nullptr),
+          journal(nullptr),
+          journalId(0),
+          queue(nullptr),
+          queueParameter(0),
+          eventTime(0),
           minimum(0.0f),
           maximum(1.0f),
           step(0.0f),
@@ -150,11 +340,19 @@ struct SliderEventHandler::PrivateData
           dragging(false),
           inverted(false),
           valueIsSet(false),
+          quantizedRepaints(false),
+          dragStartValue(value),
+          motionPending(false),
+          motionValue(value),
+          motionInterval(0),
+          lastMotionTime(0),
           startedX(0.0),
           startedY(0.0),
           startPos(),
           endPos(),
-          sliderArea()
+          sliderArea(),
+          thumbSize(),
+          curve()
     {
     }
 
@@ -162,6 +360,12 @@ struct SliderEventHandler::PrivateData
         : self(s),
           widget(w),
           callback(other->callback),
+          scheduler(other->scheduler),
+          journal(other->journal),
+          journalId(other->journalId),
+          queue(other->queue),
+          queueParameter(other->queueParameter),
+          eventTime(0),
           minimum(other->minimum),
           maximum(other->maximum),
           step(other->step),
@@ -169,20 +373,54 @@ struct SliderEventHandler::PrivateData
           valueDef(other->valueDef),
           valueTmp(value),
           usingDefault(other->usingDefault),
-          usingLog(other->usingDefault),
+          usingLog(other->usingLog),
           startPos(other->startPos),
           endPos(other->endPos),
           dragging(false),
           inverted(other->inverted),
           valueIsSet(false),
-          sliderArea(other->sliderArea)
+          quantizedRepaints(other->quantizedRepaints),
+          dragStartValue(value),
+          motionPending(false),
+          motionValue(value),
+          motionInterval(other->motionInterval),
+          lastMotionTime(0),
+          sliderArea(other->sliderArea),
+          thumbSize(other->thumbSize),
+          curve(other->curve)
 
     {
     }
 
+    void repaintValueArea(const Rectangle<double> &area)
+    {
+        DGL_TRACE_POINT(kTraceHandler, kPointRepaintRequested, widget);
+
+        if (scheduler != nullptr)
+        {
+            DGL_AUDIT_SUSPEND();
+            scheduler->markDirty(widget, area, this);
+        }
+        else
+        {
+            self->repaintValueArea(area);
+        }
+    }
+
+    // flushed scheduler areas, the handler decides how much to repaint
+    void repaintArea(const Rectangle<double> &area) override
+    {
+        self->repaintValueArea(area);
+    }
+
     void assignFrom(PrivateData *const other)
     {
         callback = other->callback;
+        scheduler = other->scheduler;
+        journal = other->journal;
+        journalId = other->journalId;
+        queue = other->queue;
+        queueParameter = other->queueParameter;
         minimum = other->minimum;
         maximum = other->maximum;
         step = other->step;
@@ -191,20 +429,9 @@ struct SliderEventHandler::PrivateData
         valueTmp = value;
         usingDefault = other->usingDefault;
         usingLog = other->usingLog;
-    }
-
-    inline float logscale(const float v) const
-    {
-        const float b = std::log(maximum / minimum) / (maximum - minimum);
-        const float a = maximum / std::exp(maximum * b);
-        return a * std::exp(b * v);
-    }
-
-    inline float invlogscale(const float v) const
-    {
-        const float b = std::log(maximum / minimum) / (maximum - minimum);
-        const float a = maximum / std::exp(maximum * b);
-        return std::log(v / a) / b;
+        quantizedRepaints = other->quantizedRepaints;
+        motionInterval = other->motionInterval;
+        curve = other->curve;
     }
 
     bool mouseEvent(const Widget::MouseEvent &ev)
@@ -212,6 +439,8 @@ struct SliderEventHandler::PrivateData
         if (ev.button != 1)
             return false;
 
+        eventTime = ev.time;
+
         if (ev.press)
         {
             if (!sliderArea.contains(ev.pos))
@@ -219,8 +448,14 @@ struct SliderEventHandler::PrivateData
 
             if ((ev.mod & kModifierShift) != 0 && usingDefault)
             {
+                const float oldValue = value;
+
                 setValue(valueDef, true);
                 valueTmp = value;
+
+                if (journal != nullptr)
+                    journal->record(journalId, oldValue, value, ev.time);
+
                 return true;
             }
 
@@ -239,12 +474,8 @@ struct SliderEventHandler::PrivateData
                 vper = float(y - sliderArea.getY()) / float(sliderArea.getHeight());
             }
 
-            float value;
-
-            if (inverted)
-                value = maximum - vper * (maximum - minimum);
-            else
-                value = minimum + vper * (maximum - minimum);
+            // the pointer moves along the curve, not the raw range
+            float value = curve.denormalize(inverted ? 1.0f - vper : vper);
 
             if (value < minimum)
             {
@@ -257,16 +488,22 @@ struct SliderEventHandler::PrivateData
             else if (d_isNotZero(step))
             {
                 valueTmp = value;
-                const float rest = std::fmod(value, step);
-                value = value - rest + (rest > step / 2.0f ? step : 0.0f);
+                value = snapToStep(value, step);
             }
 
             dragging = true;
+            dragStartValue = this->value;
             startedX = x;
             startedY = y;
+            motionPending = false;
+            lastMotionTime = ev.time;
 
             if (callback != nullptr)
+            {
+                DGL_TRACE_POINT(kTraceHandler, kPointCallbackFired, widget);
+                DGL_AUDIT_SUSPEND();
                 callback->sliderDragStarted(widget);
+            }
 
             setValue(value, true);
 
@@ -274,8 +511,18 @@ struct SliderEventHandler::PrivateData
         }
         else if (dragging)
         {
+            flushMotion();
+
+            // the whole drag is a single undo step
+            if (journal != nullptr)
+                journal->record(journalId, dragStartValue, value, ev.time);
+
             if (callback != nullptr)
+            {
+                DGL_TRACE_POINT(kTraceHandler, kPointCallbackFired, widget);
+                DGL_AUDIT_SUSPEND();
                 callback->sliderDragFinished(widget);
+            }
 
             dragging = false;
             return true;
@@ -288,6 +535,8 @@ struct SliderEventHandler::PrivateData
         if (!dragging)
             return false;
 
+        eventTime = ev.time;
+
         const bool horizontal = startPos.getY() == endPos.getY();
         const double x = ev.pos.getX();
         const double y = ev.pos.getY();
@@ -307,12 +556,8 @@ struct SliderEventHandler::PrivateData
                 vper = float(y - sliderArea.getY()) / float(sliderArea.getHeight());
             }
 
-            float value;
-
-            if (inverted)
-                value = maximum - vper * (maximum - minimum);
-            else
-                value = minimum + vper * (maximum - minimum);
+            // the pointer moves along the curve, not the raw range
+            float value = curve.denormalize(inverted ? 1.0f - vper : vper);
 
             if (value < minimum)
             {
@@ -325,59 +570,195 @@ struct SliderEventHandler::PrivateData
             else if (d_isNotZero(step))
             {
                 valueTmp = value;
-                const float rest = std::fmod(value, step);
-                value = value - rest + (rest > step / 2.0f ? step : 0.0f);
+                value = snapToStep(value, step);
             }
 
-            setValue(value, true);
+            setMotionValue(value, ev.time);
         }
         else if (horizontal)
         {
             if (x < sliderArea.getX())
-                setValue(inverted ? maximum : minimum, true);
+                setMotionValue(inverted ? maximum : minimum, ev.time);
             else
-                setValue(inverted ? minimum : maximum, true);
+                setMotionValue(inverted ? minimum : maximum, ev.time);
         }
         else
         {
             if (y < sliderArea.getY())
-                setValue(inverted ? maximum : minimum, true);
+                setMotionValue(inverted ? maximum : minimum, ev.time);
             else
-                setValue(inverted ? minimum : maximum, true);
+                setMotionValue(inverted ? minimum : maximum, ev.time);
         }
 
         return true;
     }
 
-    bool scrollEvent(const Widget::ScrollEvent &ev)
+    void setMotionValue(const float value2, const uint time)
+    {
+        if (motionInterval == 0)
+        {
+            setValue(value2, true);
+            return;
+        }
+
+        // hold on to the latest value, only deliver once per frame interval
+        motionValue = value2;
+        motionPending = true;
+
+        if (time - lastMotionTime >= motionInterval)
+        {
+            lastMotionTime = time;
+            flushMotion();
+        }
+    }
+
+    bool flushMotion()
+    {
+        if (!motionPending)
+            return false;
+
+        motionPending = false;
+        return setValue(motionValue, true);
+    }
+
+    bool scrollEvent(const Widget::ScrollEvent &)
     {
-        printf("scroll event\n");
         return false;
     }
 
     float getNormalizedValue() const noexcept
     {
-        const float diff = maximum - minimum;
-        return ((usingLog ? invlogscale(value) : value) - minimum) / diff;
+        return curve.normalize(value);
     }
 
     void setRange(const float min, const float max) noexcept
     {
         DISTRHO_SAFE_ASSERT_RETURN(max > min, );
+        DISTRHO_SAFE_ASSERT_RETURN(curve.getType() != ValueCurve::kCurveTable, );
 
         if (value < min)
         {
             valueTmp = value = min;
-            widget->repaint();
+            requestRepaint(scheduler, widget, kTraceHandler);
         }
         else if (value > max)
         {
             valueTmp = value = max;
-            widget->repaint();
+            requestRepaint(scheduler, widget, kTraceHandler);
         }
 
         minimum = min;
         maximum = max;
+        curve.setRange(min, max);
+    }
+
+    void setCurve(const ValueCurve::Type type, const float shape) noexcept
+    {
+        usingLog = type == ValueCurve::kCurveLog;
+        curve.setType(type, shape);
+        applyCurveRange();
+        requestRepaint(scheduler, widget, kTraceHandler);
+    }
+
+    void setCurveTable(const float *const values, const uint count)
+    {
+        usingLog = false;
+        curve.setTable(values, count);
+        applyCurveRange();
+        requestRepaint(scheduler, widget, kTraceHandler);
+    }
+
+    // a table curve brings its own range
+    void applyCurveRange() noexcept
+    {
+        minimum = curve.getMinimum();
+        maximum = curve.getMaximum();
+        valueTmp = value = clamp(value, maximum, minimum);
+    }
+
+    void saveState(Snapshot &state) const noexcept
+    {
+        state.value = value;
+        state.valueDef = valueDef;
+        state.minimum = minimum;
+        state.maximum = maximum;
+        state.step = step;
+        state.curve = curve.getType();
+        state.curveShape = curve.getShape();
+        state.usingDefault = usingDefault;
+        state.inverted = inverted;
+    }
+
+    void restoreState(const Snapshot &state, const bool sendCallback) noexcept
+    {
+        DISTRHO_SAFE_ASSERT_RETURN(state.maximum > state.minimum, );
+
+        const float newValue = clamp(state.value, state.maximum, state.minimum);
+
+        // step and default do not show, only what is drawn or sent decides if anything happens
+        const bool changed = d_isNotEqual(value, newValue)
+                          || d_isNotEqual(minimum, state.minimum)
+                          || d_isNotEqual(maximum, state.maximum)
+                          || curve.getType() != state.curve
+                          || d_isNotEqual(curve.getShape(), state.curveShape)
+                          || inverted != state.inverted;
+
+        step = state.step;
+        valueDef = state.valueDef;
+        usingDefault = state.usingDefault;
+
+        if (!changed)
+            return;
+
+        usingLog = state.curve == ValueCurve::kCurveLog;
+        inverted = state.inverted;
+        curve.setType(state.curve, state.curveShape);
+        if (state.curve != ValueCurve::kCurveTable)
+            curve.setRange(state.minimum, state.maximum);
+        minimum = curve.getMinimum();
+        maximum = curve.getMaximum();
+        valueTmp = value = clamp(newValue, maximum, minimum);
+
+        // range, curve and direction may all have changed, so the whole widget is dirty
+        if (ValueTransaction *const transaction = ValueTransaction::getCurrent())
+            transaction->add(this, sendCallback);
+        else
+            commitTransaction(sendCallback);
+    }
+
+    Rectangle<double> getThumbArea() const noexcept
+    {
+        const bool horizontal = startPos.getY() == endPos.getY();
+        const double thumbLength = horizontal ? thumbSize.getWidth() : thumbSize.getHeight();
+
+        if (thumbLength <= 0.0)
+            return sliderArea;
+
+        double pos = getNormalizedValue();
+
+        if (inverted)
+            pos = 1.0 - pos;
+
+        if (horizontal)
+        {
+            const double x = sliderArea.getX() + pos * sliderArea.getWidth() - thumbLength / 2.0;
+            return Rectangle<double>(x, sliderArea.getY(), thumbLength, sliderArea.getHeight());
+        }
+
+        const double y = sliderArea.getY() + pos * sliderArea.getHeight() - thumbLength / 2.0;
+        return Rectangle<double>(sliderArea.getX(), y, sliderArea.getWidth(), thumbLength);
+    }
+
+    // thumb position along the slider in whole pixels
+    int getThumbPixel() const noexcept
+    {
+        const bool horizontal = startPos.getY() == endPos.getY();
+        double pos = getNormalizedValue();
+
+        if (inverted)
+            pos = 1.0 - pos;
+
+        return static_cast<int>(std::round(pos * (horizontal ? sliderArea.getWidth() : sliderArea.getHeight())));
     }
 
     bool setValue(const float value2, const bool sendCallback)
@@ -385,19 +766,51 @@ struct SliderEventHandler::PrivateData
         if (d_isEqual(value, value2))
             return false;
 
+        const Rectangle<double> oldThumbArea(getThumbArea());
+        const int oldThumbPixel = getThumbPixel();
+
         valueTmp = value = value2;
-        widget->repaint();
+        DGL_TRACE_POINT(kTraceHandler, kPointValueChanged, widget);
+
+        if (ValueTransaction *const transaction = ValueTransaction::getCurrent())
+        {
+            transaction->add(this, sendCallback);
+            return true;
+        }
+
+        // a change that leaves the thumb on the same pixel would redraw an identical frame
+        if (!quantizedRepaints || !sliderArea.isValid() || getThumbPixel() != oldThumbPixel)
+            repaintValueArea(combineAreas(oldThumbArea, getThumbArea()));
+
+        if (sendCallback)
+            sendValue();
+
+        return true;
+    }
 
-        if (sendCallback && callback != nullptr)
+    void sendValue()
+    {
+        publishValue(queue, queueParameter, value, eventTime);
+
+        if (callback != nullptr)
         {
+            DGL_TRACE_POINT(kTraceHandler, kPointCallbackFired, widget);
+            DGL_AUDIT_SUSPEND();
+
             try
             {
                 callback->sliderValueChanged(widget, value);
             }
             DISTRHO_SAFE_EXCEPTION("SliderEventHandler::setValue");
         }
+    }
 
-        return true;
+    void commitTransaction(const bool sendCallback) override
+    {
+        requestRepaint(scheduler, widget, kTraceHandler);
+
+        if (sendCallback)
+            sendValue();
     }
 
     void setInverted(bool inv) noexcept
@@ -406,7 +819,7 @@ struct SliderEventHandler::PrivateData
             return;
 
         inverted = inv;
-        widget->repaint();
+        requestRepaint(scheduler, widget, kTraceHandler);
     }
 };
 
@@ -426,9 +839,23 @@ SliderEventHandler &SliderEventHandler::operator=(const SliderEventHandler &othe
 
 SliderEventHandler::~SliderEventHandler()
 {
+    if (pData->scheduler != nullptr)
+        pData->scheduler->cancel(pData->widget);
+
     delete pData;
 }
 
+void SliderEventHandler::setRepaintScheduler(RepaintScheduler *const scheduler) noexcept
+{
+    pData->scheduler = scheduler;
+}
+
+void SliderEventHandler::setUndoJournal(UndoJournal *const journal, const uint32_t id) noexcept
+{
+    pData->journal = journal;
+    pData->journalId = id;
+}
+
 float SliderEventHandler::getValue() const noexcept
 {
     return pData->value;
@@ -436,6 +863,7 @@ float SliderEventHandler::getValue() const noexcept
 
 bool SliderEventHandler::setValue(const float value, const bool sendCallback) noexcept
 {
+    DGL_AUDIT_ALLOCATIONS("SliderEventHandler::setValue");
     return pData->setValue(value, sendCallback);
 }
 
@@ -456,6 +884,11 @@ void SliderEventHandler::setSliderArea(const double x, const double y,
     pData->sliderArea = Rectangle<double>(x, y, w, h);
 }
 
+void SliderEventHandler::setThumbSize(const double w, const double h) noexcept
+{
+    pData->thumbSize = Size<double>(w, h);
+}
+
 void SliderEventHandler::setRange(const float min, const float max) noexcept
 {
     pData->setRange(min, max);
@@ -466,9 +899,39 @@ void SliderEventHandler::setStep(const float step) noexcept
     pData->step = step;
 }
 
+float SliderEventHandler::getStep() const noexcept
+{
+    return pData->step;
+}
+
 void SliderEventHandler::setUsingLogScale(const bool yesNo) noexcept
 {
-    pData->usingLog = yesNo;
+    pData->setCurve(yesNo ? ValueCurve::kCurveLog : ValueCurve::kCurveLinear, 1.0f);
+}
+
+void SliderEventHandler::setCurve(const ValueCurve::Type type, const float shape) noexcept
+{
+    pData->setCurve(type, shape);
+}
+
+void SliderEventHandler::setCurveTable(const float *const values, const uint count)
+{
+    pData->setCurveTable(values, count);
+}
+
+const ValueCurve &SliderEventHandler::getCurve() const noexcept
+{
+    return pData->curve;
+}
+
+void SliderEventHandler::saveState(Snapshot &state) const noexcept
+{
+    pData->saveState(state);
+}
+
+void SliderEventHandler::restoreState(const Snapshot &state, const bool sendCallback) noexcept
+{
+    pData->restoreState(state, sendCallback);
 }
 
 void SliderEventHandler::setStartPos(const int x, const int y) noexcept
@@ -486,6 +949,11 @@ void SliderEventHandler::setInverted(const bool inv) noexcept
     pData->setInverted(inv);
 }
 
+void SliderEventHandler::setQuantizedRepaints(const bool quantized) noexcept
+{
+    pData->quantizedRepaints = quantized;
+}
+
 bool SliderEventHandler::isInverted() noexcept
 {
     return pData->inverted;
@@ -496,30 +964,92 @@ void SliderEventHandler::setCallback(Callback *const callback) noexcept
     pData->callback = callback;
 }
 
+void SliderEventHandler::setParameterQueue(ParameterQueue *const queue, const uint32_t parameter) noexcept
+{
+    pData->queue = queue;
+    pData->queueParameter = parameter;
+}
+
+void SliderEventHandler::setMotionCoalescing(const uint frameIntervalInMs)
+{
+    pData->motionInterval = frameIntervalInMs;
+
+    if (frameIntervalInMs == 0)
+        pData->flushMotion();
+}
+
+bool SliderEventHandler::flushMotion() noexcept
+{
+    return pData->flushMotion();
+}
+
+Rectangle<double> SliderEventHandler::getThumbArea() const noexcept
+{
+    return pData->getThumbArea();
+}
+
+void SliderEventHandler::repaintValueArea(const Rectangle<double> &)
+{
+    pData->widget->repaint();
+}
+
 bool SliderEventHandler::mouseEvent(const Widget::MouseEvent &ev)
 {
-    return pData->mouseEvent(ev);
+    DGL_AUDIT_ALLOCATIONS("SliderEventHandler::mouseEvent");
+    DGL_TRACE_POINT(PrivateData::kTraceHandler, kPointEventReceived, pData->widget);
+
+    const bool consumed = pData->mouseEvent(ev);
+
+    if (consumed)
+        DGL_TRACE_POINT(PrivateData::kTraceHandler, kPointEventConsumed, pData->widget);
+
+    return consumed;
 }
 
 bool SliderEventHandler::motionEvent(const Widget::MotionEvent &ev)
 {
-    return pData->motionEvent(ev);
+    DGL_AUDIT_ALLOCATIONS("SliderEventHandler::motionEvent");
+    DGL_TRACE_POINT(PrivateData::kTraceHandler, kPointEventReceived, pData->widget);
+
+    const bool consumed = pData->motionEvent(ev);
+
+    if (consumed)
+        DGL_TRACE_POINT(PrivateData::kTraceHandler, kPointEventConsumed, pData->widget);
+
+    return consumed;
 }
 
 bool SliderEventHandler::scrollEvent(const Widget::ScrollEvent &ev)
 {
-    return pData->scrollEvent(ev);
+    DGL_AUDIT_ALLOCATIONS("SliderEventHandler::scrollEvent");
+    DGL_TRACE_POINT(PrivateData::kTraceHandler, kPointEventReceived, pData->widget);
+
+    const bool consumed = pData->scrollEvent(ev);
+
+    if (consumed)
+        DGL_TRACE_POINT(PrivateData::kTraceHandler, kPointEventConsumed, pData->widget);
+
+    return consumed;
 }
 // end slider
 // --------------------------------------------------------------------------------------------------------------------
 
 // begin spinner
 
-struct SpinnerEventHandler::PrivateData
+struct SpinnerEventHandler::PrivateData : PooledPrivateData,
+                                          ValueTransaction::Participant
 {
+    static const EventTrace::Handler kTraceHandler = EventTrace::kHandlerSpinner;
+
     SpinnerEventHandler *const self;
     SubWidget *const widget;
     SpinnerEventHandler::Callback *callback;
+    RepaintScheduler *scheduler;
+    UndoJournal *journal;
+    uint32_t journalId;
+    ParameterQueue *queue;
+    uint32_t queueParameter;
+    uint eventTime;
 
     float minimum;
     float maximum;
@@ -527,17 +1057,25 @@ struct SpinnerEventHandler::PrivateData
     float value;
     Rectangle<double> incArea;
     Rectangle<double> decArea;
+    ValueCurve curve;
 
     PrivateData(SpinnerEventHandler *const s, SubWidget *const w)
         : self(s),
           widget(w),
           callback(nullptr),
+          scheduler(nullptr),
+          journal(nullptr),
+          journalId(0),
+          queue(nullptr),
+          queueParameter(0),
+          eventTime(0),
           minimum(0.0f),
           maximum(1.0f),
           step(0.0f),
           value(0.5f),
           incArea(),
-          decArea()
+          decArea(),
+          curve()
     {
     }
 
@@ -545,24 +1083,37 @@ struct SpinnerEventHandler::PrivateData
         : self(s),
           widget(w),
           callback(other->callback),
+          scheduler(other->scheduler),
+          journal(other->journal),
+          journalId(other->journalId),
+          queue(other->queue),
+          queueParameter(other->queueParameter),
+          eventTime(0),
           minimum(other->minimum),
           maximum(other->maximum),
           step(other->step),
           value(other->value),
           incArea(other->incArea),
-          decArea(other->decArea)
+          decArea(other->decArea),
+          curve(other->curve)
     {
     }
 
     void assignFrom(PrivateData *const other)
     {
         callback = other->callback;
+        scheduler = other->scheduler;
+        journal = other->journal;
+        journalId = other->journalId;
+        queue = other->queue;
+        queueParameter = other->queueParameter;
         minimum = other->minimum;
         maximum = other->maximum;
         step = other->step;
         value = other->value;
         incArea = other->incArea;
         decArea = other->decArea;
+        curve = other->curve;
     }
 
     bool mouseEvent(const Widget::MouseEvent &ev)
@@ -575,15 +1126,22 @@ struct SpinnerEventHandler::PrivateData
             if (!incArea.contains(ev.pos) && !decArea.contains(ev.pos))
                 return false;
 
+            eventTime = ev.time;
+
+            const float oldValue = value;
+            float newValue = value;
+
             if (incArea.contains(ev.pos))
-                value += step;
+                newValue += step;
 
             if (decArea.contains(ev.pos))
-                value -= step;
+                newValue -= step;
 
-            value = clamp(value, maximum, minimum);
+            setValue(newValue, true);
 
-            setValue(value, true);
+            // at either end of the range a step changes nothing, keep that out of the history
+            if (journal != nullptr && d_isNotEqual(oldValue, value))
+                journal->record(journalId, oldValue, value, ev.time, true);
 
             return true;
         }
@@ -601,42 +1159,94 @@ struct SpinnerEventHandler::PrivateData
         if (!widget->contains(ev.pos))
             return false;
 
+        eventTime = ev.time;
+
+        const float oldValue = value;
+        float newValue = value;
+
         auto dir = ev.direction;
         switch (dir)
         {
         case ScrollDirection::kScrollUp:
-            value += step;
+            newValue += step;
             break;
         case ScrollDirection::kScrollDown:
-            value -= step;
+            newValue -= step;
         default:
             break;
         }
-        setValue(value, true);
+        setValue(newValue, true);
+
+        if (journal != nullptr && d_isNotEqual(oldValue, value))
+            journal->record(journalId, oldValue, value, ev.time, true);
+
         return true;
     }
 
     void setRange(const float min, const float max) noexcept
     {
         DISTRHO_SAFE_ASSERT_RETURN(max > min, );
+        DISTRHO_SAFE_ASSERT_RETURN(curve.getType() != ValueCurve::kCurveTable, );
 
         minimum = min;
         maximum = max;
+        curve.setRange(min, max);
+    }
+
+    // a table curve brings its own range
+    void applyCurveRange() noexcept
+    {
+        minimum = curve.getMinimum();
+        maximum = curve.getMaximum();
+        value = clamp(value, maximum, minimum);
     }
 
     bool setValue(const float value2, const bool sendCallback)
     {
+        const float oldValue = value;
+
         value = clamp(value2, maximum, minimum);
-        if (sendCallback && callback != nullptr)
+
+        if (d_isNotEqual(oldValue, value))
+            DGL_TRACE_POINT(kTraceHandler, kPointValueChanged, widget);
+
+        // only changed handlers join, so a transaction repaints and calls back just what changed
+        if (ValueTransaction *const transaction = ValueTransaction::getCurrent())
+        {
+            if (d_isNotEqual(oldValue, value))
+                transaction->add(this, sendCallback);
+            return true;
+        }
+
+        if (sendCallback)
+            sendValue();
+
+        return true;
+    }
+
+    void sendValue()
+    {
+        publishValue(queue, queueParameter, value, eventTime);
+
+        if (callback != nullptr)
         {
+            DGL_TRACE_POINT(kTraceHandler, kPointCallbackFired, widget);
+            DGL_AUDIT_SUSPEND();
+
             try
             {
                 callback->spinnerValueChanged(widget, value);
             }
             DISTRHO_SAFE_EXCEPTION("SpinnerEventHandler::setValue");
         }
+    }
 
-        return true;
+    void commitTransaction(const bool sendCallback) override
+    {
+        requestRepaint(scheduler, widget, kTraceHandler);
+
+        if (sendCallback)
+            sendValue();
     }
 };
 
@@ -656,9 +1266,23 @@ SpinnerEventHandler &SpinnerEventHandler::operator=(const SpinnerEventHandler &o
 
 SpinnerEventHandler::~SpinnerEventHandler()
 {
+    if (pData->scheduler != nullptr)
+        pData->scheduler->cancel(pData->widget);
+
     delete pData;
 }
 
+void SpinnerEventHandler::setRepaintScheduler(RepaintScheduler *const scheduler) noexcept
+{
+    pData->scheduler = scheduler;
+}
+
+void SpinnerEventHandler::setUndoJournal(UndoJournal *const journal, const uint32_t id) noexcept
+{
+    pData->journal = journal;
+    pData->journalId = id;
+}
+
 float SpinnerEventHandler::getValue() const noexcept
 {
     return pData->value;
@@ -666,9 +1290,56 @@ float SpinnerEventHandler::getValue() const noexcept
 
 bool SpinnerEventHandler::setValue(const float value, const bool sendCallback) noexcept
 {
+    DGL_AUDIT_ALLOCATIONS("SpinnerEventHandler::setValue");
     return pData->setValue(value, sendCallback);
 }
 
+float SpinnerEventHandler::getNormalizedValue() const noexcept
+{
+    return pData->curve.normalize(pData->value);
+}
+
+void SpinnerEventHandler::setCurve(const ValueCurve::Type type, const float shape) noexcept
+{
+    pData->curve.setType(type, shape);
+    pData->applyCurveRange();
+}
+
+void SpinnerEventHandler::setCurveTable(const float *const values, const uint count)
+{
+    pData->curve.setTable(values, count);
+    pData->applyCurveRange();
+}
+
+const ValueCurve &SpinnerEventHandler::getCurve() const noexcept
+{
+    return pData->curve;
+}
+
+void SpinnerEventHandler::saveState(Snapshot &state) const noexcept
+{
+    state.value = pData->value;
+    state.minimum = pData->minimum;
+    state.maximum = pData->maximum;
+    state.step = pData->step;
+    state.curve = pData->curve.getType();
+    state.curveShape = pData->curve.getShape();
+}
+
+void SpinnerEventHandler::restoreState(const Snapshot &state, const bool sendCallback) noexcept
+{
+    DISTRHO_SAFE_ASSERT_RETURN(state.maximum > state.minimum, );
+
+    pData->step = state.step;
+    pData->curve.setType(state.curve, state.curveShape);
+    if (state.curve != ValueCurve::kCurveTable)
+        pData->setRange(state.minimum, state.maximum);
+    // setValue clamps, and must still see the old value to tell if it changed
+    pData->minimum = pData->curve.getMinimum();
+    pData->maximum = pData->curve.getMaximum();
+    pData->setValue(state.value, sendCallback);
+}
+
 void SpinnerEventHandler::setRange(const float min, const float max) noexcept
 {
     pData->setRange(min, max);
@@ -679,6 +1350,11 @@ void SpinnerEventHandler::setStep(const float step) noexcept
     pData->step = step;
 }
 
+float SpinnerEventHandler::getStep() const noexcept
+{
+    return pData->step;
+}
+
 void SpinnerEventHandler::setIncrementArea(const double x, const double y, const double w, const double h) noexcept
 {
     pData->incArea = Rectangle<double>(x, y, w, h);
@@ -694,6 +1370,12 @@ void SpinnerEventHandler::setCallback(Callback *const callback) noexcept
     pData->callback = callback;
 }
 
+void SpinnerEventHandler::setParameterQueue(ParameterQueue *const queue, const uint32_t parameter) noexcept
+{
+    pData->queue = queue;
+    pData->queueParameter = parameter;
+}
+
 Rectangle<double> SpinnerEventHandler::getIncrementArea() noexcept
 {
     return pData->incArea;
@@ -706,28 +1388,61 @@ Rectangle<double> SpinnerEventHandler::getDecrementArea() noexcept
 
 bool SpinnerEventHandler::mouseEvent(const Widget::MouseEvent &ev)
 {
-    return pData->mouseEvent(ev);
+    DGL_AUDIT_ALLOCATIONS("SpinnerEventHandler::mouseEvent");
+    DGL_TRACE_POINT(PrivateData::kTraceHandler, kPointEventReceived, pData->widget);
+
+    const bool consumed = pData->mouseEvent(ev);
+
+    if (consumed)
+        DGL_TRACE_POINT(PrivateData::kTraceHandler, kPointEventConsumed, pData->widget);
+
+    return consumed;
 }
 
 bool SpinnerEventHandler::motionEvent(const Widget::MotionEvent &ev)
 {
-    return pData->motionEvent(ev);
+    DGL_AUDIT_ALLOCATIONS("SpinnerEventHandler::motionEvent");
+    DGL_TRACE_POINT(PrivateData::kTraceHandler, kPointEventReceived, pData->widget);
+
+    const bool consumed = pData->motionEvent(ev);
+
+    if (consumed)
+        DGL_TRACE_POINT(PrivateData::kTraceHandler, kPointEventConsumed, pData->widget);
+
+    return consumed;
 }
 
 bool SpinnerEventHandler::scrollEvent(const Widget::ScrollEvent &ev)
 {
-    return pData->scrollEvent(ev);
-    printf("scrollEvent \n");
+    DGL_AUDIT_ALLOCATIONS("SpinnerEventHandler::scrollEvent");
+    DGL_TRACE_POINT(PrivateData::kTraceHandler, kPointEventReceived, pData->widget);
+
+    const bool consumed = pData->scrollEvent(ev);
+
+    if (consumed)
+        DGL_TRACE_POINT(PrivateData::kTraceHandler, kPointEventConsumed, pData->widget);
+
+    return consumed;
 }
 // end spinner
 
 // begin radio
 
-struct RadioEventHandler::PrivateData
+struct RadioEventHandler::PrivateData : PooledPrivateData,
+                                        ValueTransaction::Participant,
+                                        RepaintScheduler::AreaRepainter
 {
+    static const EventTrace::Handler kTraceHandler = EventTrace::kHandlerRadio;
+
     RadioEventHandler *const self;
     SubWidget *const widget;
     RadioEventHandler::Callback *callback;
+    RepaintScheduler *scheduler;
+    UndoJournal *journal;
+    uint32_t journalId;
+    ParameterQueue *queue;
+    uint32_t queueParameter;
+    uint eventTime;
 
     // struct Option
     // {
@@ -746,14 +1461,37 @@ struct RadioEventHandler::PrivateData
     float maximum;
     float value;
     std::vector<Option> options;
+    std::vector<Rectangle<double>> hitboxes;
+    Layout layout;
+    uint columns;
+    double cellWidth;
+    double cellHeight;
+    bool layoutDirty;
+    uint layoutWidth;
+    uint layoutHeight;
+    uint32_t version;
 
     PrivateData(RadioEventHandler *const s, SubWidget *const w)
         : self(s),
           widget(w),
           callback(nullptr),
+          scheduler(nullptr),
+          journal(nullptr),
+          journalId(0),
+          queue(nullptr),
+          queueParameter(0),
+          eventTime(0),
           minimum(0.0f),
           maximum(1.0f),
-          value(0.0f)
+          value(0.0f),
+          layout(kLayoutColumn),
+          columns(1),
+          cellWidth(0.0),
+          cellHeight(0.0),
+          layoutDirty(true),
+          layoutWidth(0),
+          layoutHeight(0),
+          version(0)
     {
     }
 
@@ -761,18 +1499,61 @@ struct RadioEventHandler::PrivateData
         : self(s),
           widget(w),
           callback(other->callback),
+          scheduler(other->scheduler),
+          journal(other->journal),
+          journalId(other->journalId),
+          queue(other->queue),
+          queueParameter(other->queueParameter),
+          eventTime(0),
           minimum(other->minimum),
           maximum(other->maximum),
-          value(other->value)
+          value(other->value),
+          layout(other->layout),
+          columns(other->columns),
+          cellWidth(0.0),
+          cellHeight(0.0),
+          layoutDirty(true),
+          layoutWidth(0),
+          layoutHeight(0),
+          version(0)
+    {
+    }
+
+    void repaintValueArea(const Rectangle<double> &area)
     {
+        DGL_TRACE_POINT(kTraceHandler, kPointRepaintRequested, widget);
+
+        if (scheduler != nullptr)
+        {
+            DGL_AUDIT_SUSPEND();
+            scheduler->markDirty(widget, area, this);
+        }
+        else
+        {
+            self->repaintValueArea(area);
+        }
+    }
+
+    // flushed scheduler areas, the handler decides how much to repaint
+    void repaintArea(const Rectangle<double> &area) override
+    {
+        self->repaintValueArea(area);
     }
 
     void assignFrom(PrivateData *const other)
     {
         callback = other->callback;
+        scheduler = other->scheduler;
+        journal = other->journal;
+        journalId = other->journalId;
+        queue = other->queue;
+        queueParameter = other->queueParameter;
         minimum = other->minimum;
         maximum = other->maximum;
         value = other->value;
+        layout = other->layout;
+        columns = other->columns;
+        layoutDirty = true;
     }
 
     bool mouseEvent(const Widget::MouseEvent &ev)
@@ -782,11 +1563,26 @@ struct RadioEventHandler::PrivateData
 
         else
         {
+            eventTime = ev.time;
+
+            ensureLayout();
+
+            if (layout != kLayoutCustom)
+            {
+                const Option *const option = getOptionAt(ev.pos.getX(), ev.pos.getY());
+
+                if (option == nullptr)
+                    return false;
+
+                selectOption(option->value, ev.time);
+                return true;
+            }
+
             for (auto &hb : options)
             {
                 if (hb.hitbox.contains(ev.pos))
                 {
-                    setValue(hb.value, true);
+                    selectOption(hb.value, ev.time);
                     return true;
                 }
             }
@@ -795,54 +1591,199 @@ struct RadioEventHandler::PrivateData
         return false;
     }
 
+    void selectOption(const float optionValue, const uint time)
+    {
+        const float oldValue = value;
+
+        setValue(optionValue, true);
+
+        if (journal != nullptr)
+            journal->record(journalId, oldValue, value, time);
+    }
+
+    const Option *getOptionAt(const double x, const double y) const noexcept
+    {
+        if (cellWidth <= 0.0 || cellHeight <= 0.0 || x < 0.0 || y < 0.0)
+            return nullptr;
+
+        const uint column = static_cast<uint>(x / cellWidth);
+        const uint row = static_cast<uint>(y / cellHeight);
+
+        if (column >= columns)
+            return nullptr;
+
+        const size_t index = static_cast<size_t>(row) * columns + column;
+
+        return index < options.size() ? &options[index] : nullptr;
+    }
+
+    Rectangle<double> getOptionArea(const float optionValue)
+    {
+        ensureLayout();
+
+        for (const auto &option : options)
+        {
+            if (d_isEqual(option.value, optionValue))
+                return option.hitbox;
+        }
+
+        return Rectangle<double>();
+    }
+
     bool setValue(const float value2, const bool sendCallback)
     {
+        const float oldValue = value;
+
         value = clamp(value2, maximum, minimum);
-        if (sendCallback && callback != nullptr)
+
+        if (d_isNotEqual(oldValue, value))
+            DGL_TRACE_POINT(kTraceHandler, kPointValueChanged, widget);
+
+        // only changed handlers join, so a transaction repaints and calls back just what changed
+        if (ValueTransaction *const transaction = ValueTransaction::getCurrent())
         {
+            if (d_isNotEqual(oldValue, value))
+                transaction->add(this, sendCallback);
+            return true;
+        }
+
+        if (d_isNotEqual(oldValue, value))
+            repaintValueArea(combineAreas(getOptionArea(oldValue), getOptionArea(value)));
+
+        if (sendCallback)
+            sendValue();
+
+        return true;
+    }
+
+    void sendValue()
+    {
+        publishValue(queue, queueParameter, value, eventTime);
+
+        if (callback != nullptr)
+        {
+            DGL_TRACE_POINT(kTraceHandler, kPointCallbackFired, widget);
+            DGL_AUDIT_SUSPEND();
+
             try
             {
                 callback->radioValueChanged(widget, value);
             }
             DISTRHO_SAFE_EXCEPTION("RadioEventHandler::setValue");
         }
+    }
 
-        return true;
+    void commitTransaction(const bool sendCallback) override
+    {
+        requestRepaint(scheduler, widget, kTraceHandler);
+
+        if (sendCallback)
+            sendValue();
     }
 
+    // hitboxes grow with the options, so laying them out from an event never allocates
     void addOption(const char *name, float value)
     {
-        options.emplace_back(Option(name, value));
-        initHitboxes();
+        options.emplace_back(name, value);
+        hitboxes.reserve(options.capacity());
+        layoutDirty = true;
+    }
+
+    void setOptions(const Option *const newOptions, const uint count)
+    {
+        options.assign(newOptions, newOptions + count);
+        hitboxes.reserve(options.capacity());
+        layoutDirty = true;
     }
 
     void getOptions(std::vector<Option> &returnOptions)
     {
+        ensureLayout();
         returnOptions = options;
     }
 
-    void getHitboxes(std::vector<Rectangle<double>> &hitboxes)
+    void getHitboxes(std::vector<Rectangle<double>> &returnHitboxes)
     {
-        for (auto option : options)
-        {
-            hitboxes.push_back(option.hitbox);
-        }
+        ensureLayout();
+        returnHitboxes.insert(returnHitboxes.end(), hitboxes.begin(), hitboxes.end());
+    }
+
+    // hitboxes are only laid out again when options, layout or size changed since last use
+    void ensureLayout()
+    {
+        if (!layoutDirty && layoutWidth == widget->getWidth() && layoutHeight == widget->getHeight())
+            return;
+
+        layoutDirty = false;
+        layoutWidth = widget->getWidth();
+        layoutHeight = widget->getHeight();
+
+        initHitboxes();
+
+        hitboxes.resize(options.size());
+
+        for (size_t i = 0; i < options.size(); ++i)
+            hitboxes[i] = options[i].hitbox;
+
+        ++version;
     }
 
     void initHitboxes()
     {
-        const int numOptions = options.size();
-        const double widgetHeight = widget->getHeight();
-        const double widgetWidth = widget->getWidth();
-        const double hitboxHeight = widgetHeight / static_cast<float>(numOptions);
-        const double hitboxWidth = widgetWidth;
-        double y = 0;
-        for (auto &hb : options)
+        const uint numOptions = static_cast<uint>(options.size());
+
+        if (layout == kLayoutCustom || numOptions == 0)
+            return;
+
+        uint numColumns, numRows;
+
+        switch (layout)
         {
-            hb.hitbox = Rectangle<double>(0, y, hitboxWidth, hitboxHeight);
-            y += hitboxHeight;
+        case kLayoutRow:
+            numColumns = numOptions;
+            numRows = 1;
+            break;
+        case kLayoutGrid:
+            numColumns = std::max(1u, columns);
+            numRows = (numOptions + numColumns - 1) / numColumns;
+            break;
+        default:
+            numColumns = 1;
+            numRows = numOptions;
+            break;
+        }
+
+        columns = numColumns;
+        cellWidth = widget->getWidth() / static_cast<double>(numColumns);
+        cellHeight = widget->getHeight() / static_cast<double>(numRows);
+
+        for (uint i = 0; i < numOptions; ++i)
+        {
+            options[i].hitbox = Rectangle<double>((i % numColumns) * cellWidth,
+                                                  (i / numColumns) * cellHeight,
+                                                  cellWidth,
+                                                  cellHeight);
         }
     }
+
+    void setLayout(const Layout newLayout, const uint newColumns)
+    {
+        layout = newLayout;
+        columns = newColumns;
+        layoutDirty = true;
+        requestRepaint(scheduler, widget, kTraceHandler);
+    }
+
+    void setOptionHitbox(const uint index, const Rectangle<double> &hitbox)
+    {
+        DISTRHO_SAFE_ASSERT_RETURN(index < options.size(), );
+
+        ensureLayout();
+
+        layout = kLayoutCustom;
+        options[index].hitbox = hitboxes[index] = hitbox;
+        ++version;
+    }
 };
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -861,9 +1802,23 @@ RadioEventHandler &RadioEventHandler::operator=(const RadioEventHandler &other)
 
 RadioEventHandler::~RadioEventHandler()
 {
+    if (pData->scheduler != nullptr)
+        pData->scheduler->cancel(pData->widget);
+
     delete pData;
 }
 
+void RadioEventHandler::setRepaintScheduler(RepaintScheduler *const scheduler) noexcept
+{
+    pData->scheduler = scheduler;
+}
+
+void RadioEventHandler::setUndoJournal(UndoJournal *const journal, const uint32_t id) noexcept
+{
+    pData->journal = journal;
+    pData->journalId = id;
+}
+
 float RadioEventHandler::getValue() const noexcept
 {
     return pData->value;
@@ -871,6 +1826,7 @@ float RadioEventHandler::getValue() const noexcept
 
 bool RadioEventHandler::setValue(const float value, const bool sendCallback) noexcept
 {
+    DGL_AUDIT_ALLOCATIONS("RadioEventHandler::setValue");
     return pData->setValue(value, sendCallback);
 }
 
@@ -879,6 +1835,23 @@ void RadioEventHandler::addOption(const char *optName, float val)
     pData->addOption(optName, val);
 }
 
+void RadioEventHandler::setOptions(const Option *const options, const uint count)
+{
+    pData->setOptions(options, count);
+}
+
+RadioEventHandler::View<RadioEventHandler::Option> RadioEventHandler::getOptionsView()
+{
+    pData->ensureLayout();
+    return View<Option>(pData->options.data(), static_cast<uint>(pData->options.size()), pData->version);
+}
+
+RadioEventHandler::View<Rectangle<double>> RadioEventHandler::getHitboxesView()
+{
+    pData->ensureLayout();
+    return View<Rectangle<double>>(pData->hitboxes.data(), static_cast<uint>(pData->hitboxes.size()), pData->version);
+}
+
 void RadioEventHandler::getHitboxes(std::vector<Rectangle<double>> &hitboxes)
 {
     pData->getHitboxes(hitboxes);
@@ -891,7 +1864,33 @@ void RadioEventHandler::getOptions(std::vector<Option> &options)
 
 void RadioEventHandler::initHitboxes()
 {
-    pData->initHitboxes();
+    pData->layoutDirty = true;
+}
+
+void RadioEventHandler::setLayout(const Layout layout, const uint columns)
+{
+    pData->setLayout(layout, columns);
+}
+
+void RadioEventHandler::setOptionHitbox(const uint index, const Rectangle<double> &hitbox)
+{
+    pData->setOptionHitbox(index, hitbox);
+}
+
+void RadioEventHandler::saveState(Snapshot &state) const noexcept
+{
+    state.value = pData->value;
+    state.minimum = pData->minimum;
+    state.maximum = pData->maximum;
+}
+
+void RadioEventHandler::restoreState(const Snapshot &state, const bool sendCallback) noexcept
+{
+    DISTRHO_SAFE_ASSERT_RETURN(state.maximum >= state.minimum, );
+
+    pData->minimum = state.minimum;
+    pData->maximum = state.maximum;
+    pData->setValue(state.value, sendCallback);
 }
 
 void RadioEventHandler::setCallback(Callback *const callback) noexcept
@@ -899,9 +1898,28 @@ void RadioEventHandler::setCallback(Callback *const callback) noexcept
     pData->callback = callback;
 }
 
+void RadioEventHandler::setParameterQueue(ParameterQueue *const queue, const uint32_t parameter) noexcept
+{
+    pData->queue = queue;
+    pData->queueParameter = parameter;
+}
+
+void RadioEventHandler::repaintValueArea(const Rectangle<double> &)
+{
+    pData->widget->repaint();
+}
+
 bool RadioEventHandler::mouseEvent(const Widget::MouseEvent &ev)
 {
-    return pData->mouseEvent(ev);
+    DGL_AUDIT_ALLOCATIONS("RadioEventHandler::mouseEvent");
+    DGL_TRACE_POINT(PrivateData::kTraceHandler, kPointEventReceived, pData->widget);
+
+    const bool consumed = pData->mouseEvent(ev);
+
+    if (consumed)
+        DGL_TRACE_POINT(PrivateData::kTraceHandler, kPointEventConsumed, pData->widget);
+
+    return consumed;
 }
 // end Radio
 
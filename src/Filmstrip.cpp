@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#include "Filmstrip.hpp"
+#include "NanoDisplayList.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+FilmstripLayout::FilmstripLayout() noexcept
+    : numFrames(0),
+      frameWidth(0),
+      frameHeight(0),
+      columns(1)
+{
+}
+
+FilmstripLayout::FilmstripLayout(const uint frames, const uint width, const uint height, const uint cols) noexcept
+    : numFrames(frames),
+      frameWidth(width),
+      frameHeight(height),
+      columns(cols != 0 ? cols : 1)
+{
+}
+
+uint FilmstripLayout::getNumFrames() const noexcept
+{
+    return numFrames;
+}
+
+Size<uint> FilmstripLayout::getFrameSize() const noexcept
+{
+    return Size<uint>(frameWidth, frameHeight);
+}
+
+Size<uint> FilmstripLayout::getImageSize() const noexcept
+{
+    const uint usedColumns = numFrames < columns ? numFrames : columns;
+    const uint rows = (numFrames + columns - 1) / columns;
+
+    return Size<uint>(usedColumns * frameWidth, rows * frameHeight);
+}
+
+uint FilmstripLayout::getFrameIndex(const float normalizedValue) const noexcept
+{
+    if (numFrames <= 1)
+        return 0;
+
+    const float value = std::max(0.0f, std::min(1.0f, normalizedValue));
+
+    return static_cast<uint>(std::lround(value * static_cast<float>(numFrames - 1)));
+}
+
+Rectangle<double> FilmstripLayout::getFrameArea(const uint index, const double scale) const noexcept
+{
+    DISTRHO_SAFE_ASSERT_RETURN(index < numFrames, Rectangle<double>());
+
+    return Rectangle<double>(static_cast<double>((index % columns) * frameWidth) * scale,
+                             static_cast<double>((index / columns) * frameHeight) * scale,
+                             static_cast<double>(frameWidth) * scale,
+                             static_cast<double>(frameHeight) * scale);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+Filmstrip::Filmstrip(const FilmstripLayout &l)
+    : layout(l),
+      numVariants(0)
+{
+}
+
+const FilmstripLayout &Filmstrip::getLayout() const noexcept
+{
+    return layout;
+}
+
+Filmstrip::Variant *Filmstrip::addVariant(const double scale)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(scale > 0.0, nullptr);
+    DISTRHO_SAFE_ASSERT_RETURN(numVariants < kMaxVariants, nullptr);
+
+    Variant &variant(variants[numVariants++]);
+    variant.scale = scale;
+    variant.data = nullptr;
+    variant.dataSize = 0;
+    variant.failed = false;
+    return &variant;
+}
+
+bool Filmstrip::addImageFromFile(const char *const filename, const double scale)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(filename != nullptr && filename[0] != '\0', false);
+
+    Variant *const variant = addVariant(scale);
+
+    if (variant == nullptr)
+        return false;
+
+    variant->filename.assign(filename, filename + std::strlen(filename) + 1);
+    return true;
+}
+
+bool Filmstrip::addImageFromMemory(const uchar *const data, const uint dataSize, const double scale)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(data != nullptr && dataSize != 0, false);
+
+    Variant *const variant = addVariant(scale);
+
+    if (variant == nullptr)
+        return false;
+
+    variant->data = data;
+    variant->dataSize = dataSize;
+    return true;
+}
+
+int Filmstrip::selectVariant(const double scaleFactor) const noexcept
+{
+    int best = -1;
+
+    for (uint i = 0; i < numVariants; ++i)
+    {
+        if (best < 0)
+        {
+            best = static_cast<int>(i);
+            continue;
+        }
+
+        const double scale = variants[i].scale;
+        const double bestScale = variants[best].scale;
+
+        // smallest image that does not need upscaling, else the largest one
+        if (bestScale < scaleFactor ? scale > bestScale : (scale >= scaleFactor && scale < bestScale))
+            best = static_cast<int>(i);
+    }
+
+    return best;
+}
+
+bool Filmstrip::loadImage(NanoVG &nvg, Variant &variant)
+{
+    if (variant.image.isValid())
+        return true;
+
+    // do not retry a broken image on every frame
+    if (variant.failed)
+        return false;
+
+    if (variant.data != nullptr)
+        variant.image = nvg.createImageFromMemory(const_cast<uchar *>(variant.data), variant.dataSize, kImageNone);
+    else
+        variant.image = nvg.createImageFromFile(variant.filename.data(), kImageNone);
+
+    variant.failed = !variant.image.isValid();
+    return !variant.failed;
+}
+
+// a single image filled rectangle, on NanoVG or recorded into a NanoDisplayList
+template <class Target>
+static void drawFrame(Target &target, const Rectangle<double> &area, const NanoVG::Paint &paint)
+{
+    target.beginPath();
+    target.rect(static_cast<float>(area.getX()), static_cast<float>(area.getY()),
+                static_cast<float>(area.getWidth()), static_cast<float>(area.getHeight()));
+    target.fillPaint(paint);
+    target.fill();
+}
+
+bool Filmstrip::getFramePaint(NanoVG &nvg, const Rectangle<double> &area, const float normalizedValue,
+                              const double scaleFactor, NanoVG::Paint &paint)
+{
+    const int index = selectVariant(scaleFactor);
+
+    if (index < 0 || layout.getNumFrames() == 0)
+        return false;
+
+    Variant &variant(variants[index]);
+
+    if (!loadImage(nvg, variant))
+        return false;
+
+    const Rectangle<double> frame(layout.getFrameArea(layout.getFrameIndex(normalizedValue), variant.scale));
+    const Size<uint> imageSize(variant.image.getSize());
+
+    // map the frame onto the area, the image pattern then covers the whole image at that scale
+    const double scaleX = area.getWidth() / frame.getWidth();
+    const double scaleY = area.getHeight() / frame.getHeight();
+
+    paint = nvg.imagePattern(static_cast<float>(area.getX() - frame.getX() * scaleX),
+                             static_cast<float>(area.getY() - frame.getY() * scaleY),
+                             static_cast<float>(imageSize.getWidth() * scaleX),
+                             static_cast<float>(imageSize.getHeight() * scaleY),
+                             0.0f, variant.image, 1.0f);
+    return true;
+}
+
+void Filmstrip::draw(NanoVG &nvg, const Rectangle<double> &area, const float normalizedValue,
+                     const double scaleFactor)
+{
+    NanoVG::Paint paint;
+
+    if (getFramePaint(nvg, area, normalizedValue, scaleFactor, paint))
+        drawFrame(nvg, area, paint);
+}
+
+void Filmstrip::draw(NanoDisplayList &list, NanoVG &nvg, const Rectangle<double> &area,
+                     const float normalizedValue, const double scaleFactor)
+{
+    NanoVG::Paint paint;
+
+    if (getFramePaint(nvg, area, normalizedValue, scaleFactor, paint))
+        drawFrame(list, area, paint);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
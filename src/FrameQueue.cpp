@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#include "FrameQueue.hpp"
+#include "Helpers.hpp"
+
+#include <cstring>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+FrameQueue::FrameQueue(const uint32_t size, const uint32_t capacity)
+    : buffer(new float[static_cast<size_t>(size) * roundToPowerOf2(capacity)]),
+      frameSize(size),
+      mask(roundToPowerOf2(capacity) - 1),
+      writeIndex(0),
+      readIndex(0)
+{
+}
+
+FrameQueue::~FrameQueue()
+{
+    delete[] buffer;
+}
+
+uint32_t FrameQueue::getFrameSize() const noexcept
+{
+    return frameSize;
+}
+
+float *FrameQueue::beginWrite() noexcept
+{
+    const uint32_t write = writeIndex.load(std::memory_order_relaxed);
+
+    if (write - readIndex.load(std::memory_order_acquire) > mask)
+        return nullptr;
+
+    return buffer + static_cast<size_t>(write & mask) * frameSize;
+}
+
+void FrameQueue::commitWrite() noexcept
+{
+    writeIndex.store(writeIndex.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+bool FrameQueue::push(const float *const frame) noexcept
+{
+    float *const slot = beginWrite();
+
+    if (slot == nullptr)
+        return false;
+
+    std::memcpy(slot, frame, sizeof(float) * frameSize);
+    commitWrite();
+    return true;
+}
+
+const float *FrameQueue::front() const noexcept
+{
+    const uint32_t read = readIndex.load(std::memory_order_relaxed);
+
+    if (read == writeIndex.load(std::memory_order_acquire))
+        return nullptr;
+
+    return buffer + static_cast<size_t>(read & mask) * frameSize;
+}
+
+void FrameQueue::pop() noexcept
+{
+    const uint32_t read = readIndex.load(std::memory_order_relaxed);
+
+    if (read != writeIndex.load(std::memory_order_acquire))
+        readIndex.store(read + 1, std::memory_order_release);
+}
+
+bool FrameQueue::isEmpty() const noexcept
+{
+    return readIndex.load(std::memory_order_acquire) == writeIndex.load(std::memory_order_acquire);
+}
+
+void FrameQueue::clear() noexcept
+{
+    readIndex.store(writeIndex.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
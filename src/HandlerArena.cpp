@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#include "HandlerArena.hpp"
+
+#include <new>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+// every handler allocation is prefixed with the arena it came from (or nullptr for the heap),
+// padded so the data after it stays suitably aligned
+static const std::size_t kAlignment = alignof(std::max_align_t);
+static const std::size_t kHeaderSize = (sizeof(HandlerArena *) + kAlignment - 1) & ~(kAlignment - 1);
+
+static inline std::size_t alignSize(const std::size_t size) noexcept
+{
+    return (size + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+struct HandlerArena::Block
+{
+    Block *next;
+    std::size_t size;
+    std::size_t used;
+
+    uint8_t *getData() noexcept
+    {
+        return reinterpret_cast<uint8_t *>(this) + alignSize(sizeof(Block));
+    }
+};
+
+HandlerArena *HandlerArena::current = nullptr;
+
+// --------------------------------------------------------------------------------------------------------------------
+
+HandlerArena::HandlerArena(const std::size_t size)
+    : blockSize(alignSize(size)),
+      blocks(nullptr),
+      bytesUsed(0),
+      bytesReserved(0),
+      numAllocations(0),
+      numLiveAllocations(0)
+{
+}
+
+HandlerArena::~HandlerArena()
+{
+    // handlers still alive would point into the memory freed below
+    DISTRHO_SAFE_ASSERT(numLiveAllocations == 0);
+    DISTRHO_SAFE_ASSERT(current != this);
+
+    for (Block *block = blocks; block != nullptr;)
+    {
+        Block *const next = block->next;
+        ::operator delete(block);
+        block = next;
+    }
+}
+
+void *HandlerArena::allocate(std::size_t size)
+{
+    size = alignSize(size);
+
+    if (size > blockSize)
+    {
+        // oversized requests get a block of their own, kept behind the one being filled
+        Block *const block = createBlock(size);
+        block->used = size;
+
+        if (blocks != nullptr)
+        {
+            block->next = blocks->next;
+            blocks->next = block;
+        }
+        else
+        {
+            blocks = block;
+        }
+
+        bytesUsed += size;
+        ++numAllocations;
+        return block->getData();
+    }
+
+    if (blocks == nullptr || blocks->used + size > blocks->size)
+    {
+        Block *const block = createBlock(blockSize);
+        block->next = blocks;
+        blocks = block;
+    }
+
+    void *const ptr = blocks->getData() + blocks->used;
+    blocks->used += size;
+    bytesUsed += size;
+    ++numAllocations;
+    return ptr;
+}
+
+HandlerArena::Block *HandlerArena::createBlock(const std::size_t size)
+{
+    Block *const block = static_cast<Block *>(::operator new(alignSize(sizeof(Block)) + size));
+    block->next = nullptr;
+    block->size = size;
+    block->used = 0;
+
+    bytesReserved += size;
+    return block;
+}
+
+std::size_t HandlerArena::getBytesUsed() const noexcept
+{
+    return bytesUsed;
+}
+
+std::size_t HandlerArena::getBytesReserved() const noexcept
+{
+    return bytesReserved;
+}
+
+uint HandlerArena::getNumAllocations() const noexcept
+{
+    return numAllocations;
+}
+
+HandlerArena *HandlerArena::getCurrent() noexcept
+{
+    return current;
+}
+
+void *HandlerArena::allocateHandlerData(const std::size_t size)
+{
+    HandlerArena *const arena = current;
+    void *const ptr = arena != nullptr ? arena->allocate(kHeaderSize + size)
+                                       : ::operator new(kHeaderSize + size);
+
+    *static_cast<HandlerArena **>(ptr) = arena;
+
+    if (arena != nullptr)
+        ++arena->numLiveAllocations;
+
+    return static_cast<uint8_t *>(ptr) + kHeaderSize;
+}
+
+void HandlerArena::releaseHandlerData(void *const ptr) noexcept
+{
+    if (ptr == nullptr)
+        return;
+
+    void *const base = static_cast<uint8_t *>(ptr) - kHeaderSize;
+    HandlerArena *const arena = *static_cast<HandlerArena **>(base);
+
+    // arena memory is only given back when the arena goes away
+    if (arena != nullptr)
+        --arena->numLiveAllocations;
+    else
+        ::operator delete(base);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+HandlerArena::Scope::Scope(HandlerArena &arena) noexcept
+    : previous(current)
+{
+    current = &arena;
+}
+
+HandlerArena::Scope::~Scope() noexcept
+{
+    current = previous;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
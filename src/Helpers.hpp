@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#pragma once
+
+#include "Base.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+// internal helpers shared by the sources in src/, not installed
+
+// smallest power of 2 >= capacity, at least 2, so ring buffer indices wrap with a mask
+static inline uint32_t roundToPowerOf2(const uint32_t capacity) noexcept
+{
+    uint32_t size = 2;
+
+    while (size < capacity && size < 0x80000000u)
+        size <<= 1;
+
+    return size;
+}
+
+// seconds on a monotonic clock, only differences are meaningful
+static inline double getCurrentTime() noexcept
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// level display ballistics, shared by NanoMeter and NanoSpectrum
+
+// one pole smoothing coefficient for a time constant in ms
+static inline float getCoefficient(const float time, const float deltaTime) noexcept
+{
+    return time > 0.0f ? 1.0f - std::exp(-deltaTime * 1000.0f / time) : 1.0f;
+}
+
+// moves `levels` towards `targets`, rising with `attack` and falling with `release` coefficients.
+// branch free so it vectorizes, returns the largest step taken
+static inline float smoothLevels(const float *const targets, float *const levels, const uint count,
+                                 const float attack, const float release) noexcept
+{
+    float maxDelta = 0.0f;
+
+    for (uint i = 0; i < count; ++i)
+    {
+        const float delta = (targets[i] - levels[i]) * (targets[i] > levels[i] ? attack : release);
+        levels[i] += delta;
+        maxDelta = std::max(maxDelta, std::fabs(delta));
+    }
+
+    return maxDelta;
+}
+
+// true if a 0-1 display position moved by half a pixel or more over `height` pixels
+static inline bool isVisibleChange(const float maxDelta, const uint height) noexcept
+{
+    return maxDelta * static_cast<float>(height) >= 0.5f;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
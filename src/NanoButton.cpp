@@ -4,6 +4,7 @@
 */
 
 #include "NanoButton.hpp"
+#include "EventRecorder.hpp"
 
 START_NAMESPACE_DGL
 
@@ -17,6 +18,7 @@ NanoButton::NanoButton(Widget* const parent, ButtonEventHandler::Callback* const
 
 bool NanoButton::onMouse(const MouseEvent& ev)
 {
+    EventRecorder::recordMouse(this, ev);
     return ButtonEventHandler::mouseEvent(ev);
 }
 
@@ -0,0 +1,682 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#include "NanoDisplayList.hpp"
+#include "Helpers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+static inline Color readColor(const float *const a) noexcept
+{
+    return Color(a[0], a[1], a[2], a[3]);
+}
+
+// paints are stored as transform, extent, radius, feather and both colors, the image id goes in Command::data
+static const uint kPaintArgs = 18;
+
+static NanoVG::Paint readPaint(const float *const a, const uint32_t imageId) noexcept
+{
+    NanoVG::Paint paint;
+    std::memcpy(paint.xform, a, sizeof(paint.xform));
+    paint.extent[0] = a[6];
+    paint.extent[1] = a[7];
+    paint.radius = a[8];
+    paint.feather = a[9];
+    paint.innerColor = readColor(a + 10);
+    paint.outerColor = readColor(a + 14);
+    paint.imageId = static_cast<int>(imageId);
+    return paint;
+}
+
+static NanoVG::Paint makePaint(const float x, const float y, const float w, const float h,
+                               const float r, const float f, const Color &icol, const Color &ocol) noexcept
+{
+    NanoVG::Paint paint;
+    paint.xform[0] = 1.0f;
+    paint.xform[1] = 0.0f;
+    paint.xform[2] = 0.0f;
+    paint.xform[3] = 1.0f;
+    paint.xform[4] = x;
+    paint.xform[5] = y;
+    paint.extent[0] = w;
+    paint.extent[1] = h;
+    paint.radius = r;
+    paint.feather = std::max(1.0f, f);
+    paint.innerColor = icol;
+    paint.outerColor = ocol;
+    paint.imageId = 0;
+    return paint;
+}
+
+// points nanovg turns an arc into, the same division into at most 5 bezier segments as nvgArc()
+static uint getArcPoints(const float a0, const float a1, const NanoVG::Winding dir) noexcept
+{
+    const float twoPi = static_cast<float>(M_PI * 2.0);
+    float da = a1 - a0;
+
+    if (dir == NanoVG::CW)
+    {
+        if (std::fabs(da) >= twoPi)
+            da = twoPi;
+        else
+            while (da < 0.0f)
+                da += twoPi;
+    }
+    else
+    {
+        if (std::fabs(da) >= twoPi)
+            da = -twoPi;
+        else
+            while (da > 0.0f)
+                da -= twoPi;
+    }
+
+    const int divs = static_cast<int>(std::fabs(da) / static_cast<float>(M_PI * 0.5) + 0.5f);
+
+    return 1 + 3 * static_cast<uint>(std::max(1, std::min(divs, 5)));
+}
+
+static const char *const kOpNames[] = {
+    "save", "restore", "resetTransform", "translate", "rotate", "scale", "globalAlpha",
+    "scissor", "intersectScissor", "resetScissor",
+    "beginPath", "moveTo", "lineTo", "bezierTo", "quadTo", "arcTo", "arc", "closePath", "pathWinding",
+    "rect", "roundedRect", "ellipse", "circle",
+    "fillColor", "strokeColor", "fillPaint", "strokePaint", "strokeWidth", "lineCap", "lineJoin", "miterLimit",
+    "fillLinearGradient", "fillRadialGradient", "fill", "stroke",
+    "fontFace", "fontFaceId", "fontSize", "textAlign", "text", "textBox"
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+NanoDisplayList::NanoDisplayList()
+    : key(0),
+      recorded(false),
+      recording(false),
+      stats(),
+      beginTime(0.0)
+{
+}
+
+bool NanoDisplayList::isRecorded(const uint32_t k) const noexcept
+{
+    return recorded && key == k;
+}
+
+void NanoDisplayList::begin(const uint32_t k)
+{
+    clear();
+    key = k;
+    recording = true;
+    beginTime = getCurrentTime();
+}
+
+void NanoDisplayList::end() noexcept
+{
+    DISTRHO_SAFE_ASSERT_RETURN(recording, );
+
+    recording = false;
+    recorded = true;
+
+    updateStats();
+    stats.recordingSeconds = getCurrentTime() - beginTime;
+}
+
+void NanoDisplayList::clear() noexcept
+{
+    commands.clear();
+    args.clear();
+    strings.clear();
+    recorded = recording = false;
+    stats = Stats();
+}
+
+uint NanoDisplayList::getNumCommands() const noexcept
+{
+    return static_cast<uint>(commands.size());
+}
+
+const NanoDisplayList::Stats &NanoDisplayList::getStats() const noexcept
+{
+    return stats;
+}
+
+void NanoDisplayList::updateStats() noexcept
+{
+    const float *const argData = args.data();
+
+    stats = Stats();
+
+    for (const Command &cmd : commands)
+    {
+        const float *const a = argData + cmd.index;
+
+        switch (cmd.op)
+        {
+        case kOpMoveTo:
+        case kOpLineTo:
+            stats.vertices += 1;
+            break;
+        case kOpBezierTo:
+        case kOpQuadTo:
+            // quads are stored as beziers too
+            stats.vertices += 3;
+            break;
+        case kOpArcTo:
+            // a line to the start of the arc and a single bezier for the usual corner of 90 degrees or less
+            stats.vertices += 4;
+            break;
+        case kOpArc:
+            stats.vertices += getArcPoints(a[3], a[4], static_cast<NanoVG::Winding>(static_cast<int>(a[5])));
+            break;
+        case kOpRect:
+            stats.vertices += 4;
+            break;
+        case kOpRoundedRect:
+            // 4 lines and 4 corner beziers, plain rect below 0.1 radius
+            stats.vertices += a[4] < 0.1f ? 4 : 17;
+            break;
+        case kOpEllipse:
+        case kOpCircle:
+            stats.vertices += 13;
+            break;
+        case kOpFill:
+            ++stats.fills;
+            break;
+        case kOpStroke:
+            ++stats.strokes;
+            break;
+        case kOpText:
+        case kOpTextBox:
+            ++stats.textRuns;
+            break;
+        }
+    }
+
+    stats.drawCalls = stats.fills + stats.strokes + stats.textRuns;
+}
+
+void NanoDisplayList::write(FILE *const file) const
+{
+    DISTRHO_SAFE_ASSERT_RETURN(file != nullptr, );
+
+    for (size_t i = 0; i < commands.size(); ++i)
+    {
+        const Command &cmd(commands[i]);
+        const size_t end = i + 1 < commands.size() ? commands[i + 1].index : args.size();
+
+        std::fputs(kOpNames[cmd.op], file);
+
+        for (size_t j = cmd.index; j < end; ++j)
+            std::fprintf(file, " %g", args[j]);
+
+        switch (cmd.op)
+        {
+        case kOpFontFace:
+        case kOpText:
+        case kOpTextBox:
+            std::fprintf(file, " \"%s\"", strings.data() + cmd.data);
+            break;
+        case kOpFillPaint:
+        case kOpStrokePaint:
+            std::fprintf(file, " %u", cmd.data);
+            break;
+        }
+
+        std::fputc('\n', file);
+    }
+}
+
+void NanoDisplayList::replay(NanoVG &nvg) const
+{
+    DISTRHO_SAFE_ASSERT_RETURN(recorded, );
+
+    const float *const argData = args.data();
+
+    for (const Command &cmd : commands)
+    {
+        const float *const a = argData + cmd.index;
+
+        switch (cmd.op)
+        {
+        case kOpSave:
+            nvg.save();
+            break;
+        case kOpRestore:
+            nvg.restore();
+            break;
+        case kOpResetTransform:
+            nvg.resetTransform();
+            break;
+        case kOpTranslate:
+            nvg.translate(a[0], a[1]);
+            break;
+        case kOpRotate:
+            nvg.rotate(a[0]);
+            break;
+        case kOpScale:
+            nvg.scale(a[0], a[1]);
+            break;
+        case kOpGlobalAlpha:
+            nvg.globalAlpha(a[0]);
+            break;
+        case kOpScissor:
+            nvg.scissor(a[0], a[1], a[2], a[3]);
+            break;
+        case kOpIntersectScissor:
+            nvg.intersectScissor(a[0], a[1], a[2], a[3]);
+            break;
+        case kOpResetScissor:
+            nvg.resetScissor();
+            break;
+        case kOpBeginPath:
+            nvg.beginPath();
+            break;
+        case kOpMoveTo:
+            nvg.moveTo(a[0], a[1]);
+            break;
+        case kOpLineTo:
+            nvg.lineTo(a[0], a[1]);
+            break;
+        case kOpBezierTo:
+            nvg.bezierTo(a[0], a[1], a[2], a[3], a[4], a[5]);
+            break;
+        case kOpQuadTo:
+            nvg.quadTo(a[0], a[1], a[2], a[3]);
+            break;
+        case kOpArcTo:
+            nvg.arcTo(a[0], a[1], a[2], a[3], a[4]);
+            break;
+        case kOpArc:
+            nvg.arc(a[0], a[1], a[2], a[3], a[4], static_cast<NanoVG::Winding>(static_cast<int>(a[5])));
+            break;
+        case kOpClosePath:
+            nvg.closePath();
+            break;
+        case kOpPathWinding:
+            nvg.pathWinding(static_cast<NanoVG::Winding>(static_cast<int>(a[0])));
+            break;
+        case kOpRect:
+            nvg.rect(a[0], a[1], a[2], a[3]);
+            break;
+        case kOpRoundedRect:
+            nvg.roundedRect(a[0], a[1], a[2], a[3], a[4]);
+            break;
+        case kOpEllipse:
+            nvg.ellipse(a[0], a[1], a[2], a[3]);
+            break;
+        case kOpCircle:
+            nvg.circle(a[0], a[1], a[2]);
+            break;
+        case kOpFillColor:
+            nvg.fillColor(readColor(a));
+            break;
+        case kOpStrokeColor:
+            nvg.strokeColor(readColor(a));
+            break;
+        case kOpFillPaint:
+            nvg.fillPaint(readPaint(a, cmd.data));
+            break;
+        case kOpStrokePaint:
+            nvg.strokePaint(readPaint(a, cmd.data));
+            break;
+        case kOpStrokeWidth:
+            nvg.strokeWidth(a[0]);
+            break;
+        case kOpLineCap:
+            nvg.lineCap(static_cast<NanoVG::LineCap>(static_cast<int>(a[0])));
+            break;
+        case kOpLineJoin:
+            nvg.lineJoin(static_cast<NanoVG::LineCap>(static_cast<int>(a[0])));
+            break;
+        case kOpMiterLimit:
+            nvg.miterLimit(a[0]);
+            break;
+        case kOpFillLinearGradient:
+            nvg.fillPaint(nvg.linearGradient(a[0], a[1], a[2], a[3], readColor(a + 4), readColor(a + 8)));
+            break;
+        case kOpFillRadialGradient:
+            nvg.fillPaint(nvg.radialGradient(a[0], a[1], a[2], a[3], readColor(a + 4), readColor(a + 8)));
+            break;
+        case kOpFill:
+            nvg.fill();
+            break;
+        case kOpStroke:
+            nvg.stroke();
+            break;
+        case kOpFontFace:
+            nvg.fontFace(strings.data() + cmd.data);
+            break;
+        case kOpFontFaceId:
+            nvg.fontFaceId(static_cast<NanoVG::FontId>(a[0]));
+            break;
+        case kOpFontSize:
+            nvg.fontSize(a[0]);
+            break;
+        case kOpTextAlign:
+            nvg.textAlign(static_cast<int>(a[0]));
+            break;
+        case kOpText:
+            nvg.text(a[0], a[1], strings.data() + cmd.data, nullptr);
+            break;
+        case kOpTextBox:
+            nvg.textBox(a[0], a[1], a[2], strings.data() + cmd.data, nullptr);
+            break;
+        }
+    }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+bool NanoDisplayList::add(const Op op, const std::initializer_list<float> values, const uint32_t data)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(recording, false);
+
+    const Command cmd = { static_cast<uint8_t>(op), static_cast<uint32_t>(args.size()), data };
+    commands.push_back(cmd);
+    args.insert(args.end(), values.begin(), values.end());
+    return true;
+}
+
+void NanoDisplayList::addColor(const Color &color)
+{
+    args.push_back(color.red);
+    args.push_back(color.green);
+    args.push_back(color.blue);
+    args.push_back(color.alpha);
+}
+
+void NanoDisplayList::addPaint(const Op op, const NanoVG::Paint &paint)
+{
+    if (!add(op, {}, static_cast<uint32_t>(paint.imageId)))
+        return;
+
+    args.insert(args.end(), paint.xform, paint.xform + 6);
+    args.push_back(paint.extent[0]);
+    args.push_back(paint.extent[1]);
+    args.push_back(paint.radius);
+    args.push_back(paint.feather);
+    addColor(paint.innerColor);
+    addColor(paint.outerColor);
+
+    DISTRHO_SAFE_ASSERT(args.size() - commands.back().index == kPaintArgs);
+}
+
+void NanoDisplayList::addString(const char *const string, const char *const end)
+{
+    const std::size_t length = end != nullptr ? static_cast<std::size_t>(end - string) : std::strlen(string);
+
+    strings.insert(strings.end(), string, string + length);
+    strings.push_back('\0');
+}
+
+void NanoDisplayList::save()
+{
+    add(kOpSave);
+}
+
+void NanoDisplayList::restore()
+{
+    add(kOpRestore);
+}
+
+void NanoDisplayList::resetTransform()
+{
+    add(kOpResetTransform);
+}
+
+void NanoDisplayList::translate(const float x, const float y)
+{
+    add(kOpTranslate, {x, y});
+}
+
+void NanoDisplayList::rotate(const float angle)
+{
+    add(kOpRotate, {angle});
+}
+
+void NanoDisplayList::scale(const float x, const float y)
+{
+    add(kOpScale, {x, y});
+}
+
+void NanoDisplayList::globalAlpha(const float alpha)
+{
+    add(kOpGlobalAlpha, {alpha});
+}
+
+void NanoDisplayList::scissor(const float x, const float y, const float w, const float h)
+{
+    add(kOpScissor, {x, y, w, h});
+}
+
+void NanoDisplayList::intersectScissor(const float x, const float y, const float w, const float h)
+{
+    add(kOpIntersectScissor, {x, y, w, h});
+}
+
+void NanoDisplayList::resetScissor()
+{
+    add(kOpResetScissor);
+}
+
+void NanoDisplayList::beginPath()
+{
+    add(kOpBeginPath);
+}
+
+void NanoDisplayList::moveTo(const float x, const float y)
+{
+    add(kOpMoveTo, {x, y});
+}
+
+void NanoDisplayList::lineTo(const float x, const float y)
+{
+    add(kOpLineTo, {x, y});
+}
+
+void NanoDisplayList::bezierTo(const float c1x, const float c1y, const float c2x, const float c2y,
+                               const float x, const float y)
+{
+    add(kOpBezierTo, {c1x, c1y, c2x, c2y, x, y});
+}
+
+void NanoDisplayList::quadTo(const float cx, const float cy, const float x, const float y)
+{
+    add(kOpQuadTo, {cx, cy, x, y});
+}
+
+void NanoDisplayList::arcTo(const float x1, const float y1, const float x2, const float y2, const float radius)
+{
+    add(kOpArcTo, {x1, y1, x2, y2, radius});
+}
+
+void NanoDisplayList::arc(const float cx, const float cy, const float r,
+                          const float a0, const float a1, const NanoVG::Winding dir)
+{
+    add(kOpArc, {cx, cy, r, a0, a1, static_cast<float>(dir)});
+}
+
+void NanoDisplayList::closePath()
+{
+    add(kOpClosePath);
+}
+
+void NanoDisplayList::pathWinding(const NanoVG::Winding dir)
+{
+    add(kOpPathWinding, {static_cast<float>(dir)});
+}
+
+void NanoDisplayList::rect(const float x, const float y, const float w, const float h)
+{
+    add(kOpRect, {x, y, w, h});
+}
+
+void NanoDisplayList::roundedRect(const float x, const float y, const float w, const float h, const float r)
+{
+    add(kOpRoundedRect, {x, y, w, h, r});
+}
+
+void NanoDisplayList::ellipse(const float cx, const float cy, const float rx, const float ry)
+{
+    add(kOpEllipse, {cx, cy, rx, ry});
+}
+
+void NanoDisplayList::circle(const float cx, const float cy, const float r)
+{
+    add(kOpCircle, {cx, cy, r});
+}
+
+void NanoDisplayList::fillColor(const Color &color)
+{
+    if (add(kOpFillColor))
+        addColor(color);
+}
+
+void NanoDisplayList::strokeColor(const Color &color)
+{
+    if (add(kOpStrokeColor))
+        addColor(color);
+}
+
+void NanoDisplayList::fillPaint(const NanoVG::Paint &paint)
+{
+    addPaint(kOpFillPaint, paint);
+}
+
+void NanoDisplayList::strokePaint(const NanoVG::Paint &paint)
+{
+    addPaint(kOpStrokePaint, paint);
+}
+
+void NanoDisplayList::strokeWidth(const float size)
+{
+    add(kOpStrokeWidth, {size});
+}
+
+void NanoDisplayList::lineCap(const NanoVG::LineCap cap)
+{
+    add(kOpLineCap, {static_cast<float>(cap)});
+}
+
+void NanoDisplayList::lineJoin(const NanoVG::LineCap join)
+{
+    add(kOpLineJoin, {static_cast<float>(join)});
+}
+
+void NanoDisplayList::miterLimit(const float limit)
+{
+    add(kOpMiterLimit, {limit});
+}
+
+void NanoDisplayList::fillLinearGradient(const float sx, const float sy, const float ex, const float ey,
+                                         const Color &icol, const Color &ocol)
+{
+    if (!add(kOpFillLinearGradient, {sx, sy, ex, ey}))
+        return;
+
+    addColor(icol);
+    addColor(ocol);
+}
+
+void NanoDisplayList::fillRadialGradient(const float cx, const float cy, const float inr, const float outr,
+                                         const Color &icol, const Color &ocol)
+{
+    if (!add(kOpFillRadialGradient, {cx, cy, inr, outr}))
+        return;
+
+    addColor(icol);
+    addColor(ocol);
+}
+
+void NanoDisplayList::fill()
+{
+    add(kOpFill);
+}
+
+void NanoDisplayList::stroke()
+{
+    add(kOpStroke);
+}
+
+NanoVG::Paint NanoDisplayList::linearGradient(const float sx, const float sy, const float ex, const float ey,
+                                              const Color &icol, const Color &ocol)
+{
+    // same as nvgLinearGradient(), a box far larger than the widget, feathered along the gradient
+    const float large = 1e5f;
+    const float d = std::sqrt((ex - sx) * (ex - sx) + (ey - sy) * (ey - sy));
+    const float dx = d > 0.0001f ? (ex - sx) / d : 0.0f;
+    const float dy = d > 0.0001f ? (ey - sy) / d : 1.0f;
+
+    NanoVG::Paint paint(makePaint(sx - dx * large, sy - dy * large, large, large + d * 0.5f, 0.0f, d, icol, ocol));
+    paint.xform[0] = dy;
+    paint.xform[1] = -dx;
+    paint.xform[2] = dx;
+    paint.xform[3] = dy;
+    return paint;
+}
+
+NanoVG::Paint NanoDisplayList::boxGradient(const float x, const float y, const float w, const float h,
+                                           const float r, const float f, const Color &icol, const Color &ocol)
+{
+    return makePaint(x + w * 0.5f, y + h * 0.5f, w * 0.5f, h * 0.5f, r, f, icol, ocol);
+}
+
+NanoVG::Paint NanoDisplayList::radialGradient(const float cx, const float cy, const float inr, const float outr,
+                                              const Color &icol, const Color &ocol)
+{
+    const float r = (inr + outr) * 0.5f;
+
+    return makePaint(cx, cy, r, r, r, outr - inr, icol, ocol);
+}
+
+void NanoDisplayList::fontFace(const char *const font)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(font != nullptr, );
+
+    if (add(kOpFontFace, {}, static_cast<uint32_t>(strings.size())))
+        addString(font, nullptr);
+}
+
+void NanoDisplayList::fontFaceId(const NanoVG::FontId font)
+{
+    add(kOpFontFaceId, {static_cast<float>(font)});
+}
+
+void NanoDisplayList::fontSize(const float size)
+{
+    add(kOpFontSize, {size});
+}
+
+void NanoDisplayList::textAlign(const int align)
+{
+    add(kOpTextAlign, {static_cast<float>(align)});
+}
+
+void NanoDisplayList::text(const float x, const float y, const char *const string, const char *const end)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(string != nullptr, );
+
+    if (add(kOpText, {x, y}, static_cast<uint32_t>(strings.size())))
+        addString(string, end);
+}
+
+void NanoDisplayList::textBox(const float x, const float y, const float breakRowWidth,
+                              const char *const string, const char *const end)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(string != nullptr, );
+
+    if (add(kOpTextBox, {x, y, breakRowWidth}, static_cast<uint32_t>(strings.size())))
+        addString(string, end);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
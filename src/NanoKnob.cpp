@@ -4,29 +4,53 @@
 */
 
 #include "NanoKnob.hpp"
+#include "EventRecorder.hpp"
 
 START_NAMESPACE_DGL
 
 NanoKnob::NanoKnob(Widget *const parent, KnobEventHandler::Callback *const cb)
     : NanoWidget(parent),
-      KnobEventHandler(this)
+      KnobEventHandler(this),
+      filmstrip(nullptr)
 {
     KnobEventHandler::setCallback(cb);
 }
 
 bool NanoKnob::onMouse(const MouseEvent &ev)
 {
+    EventRecorder::recordMouse(this, ev);
     return KnobEventHandler::mouseEvent(ev);
 }
 
 bool NanoKnob::onMotion(const MotionEvent &ev)
 {
+    EventRecorder::recordMotion(this, ev);
     return KnobEventHandler::motionEvent(ev);
 }
 
 bool NanoKnob::onScroll(const ScrollEvent &ev)
 {
+    EventRecorder::recordScroll(this, ev);
     return KnobEventHandler::scrollEvent(ev);
 }
 
+void NanoKnob::setFilmstrip(Filmstrip *const newFilmstrip) noexcept
+{
+    filmstrip = newFilmstrip;
+    repaint();
+}
+
+bool NanoKnob::drawFilmstrip()
+{
+    if (filmstrip == nullptr)
+        return false;
+
+    const TopLevelWidget *const topLevelWidget = getTopLevelWidget();
+    const double scaleFactor = topLevelWidget != nullptr ? topLevelWidget->getScaleFactor() : 1.0;
+
+    filmstrip->draw(*this, Rectangle<double>(0.0, 0.0, getWidth(), getHeight()),
+                    KnobEventHandler::getNormalizedValue(), scaleFactor);
+    return true;
+}
+
 END_NAMESPACE_DGL
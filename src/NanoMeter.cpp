@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#include "NanoMeter.hpp"
+#include "Window.hpp"
+#include "Helpers.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+NanoMeter::NanoMeter(Widget *const parent, const uint channels, const uint queueCapacity)
+    : NanoWidget(parent),
+      numChannels(channels),
+      queue(2 * channels, queueCapacity),
+      curve(),
+      targets(2 * channels, 0.0f),
+      levels(2 * channels, 0.0f),
+      holds(channels, 0.0f),
+      holdTimes(channels, 0.0f),
+      attackTime(1.0f),
+      releaseTime(300.0f),
+      holdTime(1500.0f),
+      holdReleaseTime(1000.0f),
+      channelGap(1.0f),
+      lastUpdate(0.0),
+      idleRegistered(false),
+      backgroundColor(0.1f, 0.1f, 0.1f),
+      peakColor(0.2f, 0.7f, 0.3f),
+      rmsColor(0.3f, 0.9f, 0.4f),
+      holdColor(0.9f, 0.9f, 0.9f)
+{
+    curve.setRange(-60.0f, 6.0f);
+    setRefreshInterval(16);
+}
+
+NanoMeter::~NanoMeter()
+{
+    if (idleRegistered)
+        getWindow().removeIdleCallback(this);
+}
+
+uint NanoMeter::getNumChannels() const noexcept
+{
+    return numChannels;
+}
+
+bool NanoMeter::pushLevels(const float *const peaks, const float *const rms) noexcept
+{
+    DISTRHO_SAFE_ASSERT_RETURN(peaks != nullptr, false);
+
+    float *const frame = queue.beginWrite();
+
+    if (frame == nullptr)
+        return false;
+
+    std::copy(peaks, peaks + numChannels, frame);
+
+    if (rms != nullptr)
+        std::copy(rms, rms + numChannels, frame + numChannels);
+    else
+        std::fill(frame + numChannels, frame + 2 * numChannels, 0.0f);
+
+    queue.commitWrite();
+    return true;
+}
+
+void NanoMeter::setRange(const float minDb, const float maxDb) noexcept
+{
+    DISTRHO_SAFE_ASSERT_RETURN(maxDb > minDb, );
+
+    curve.setRange(minDb, maxDb);
+    repaint();
+}
+
+void NanoMeter::setCurve(const ValueCurve::Type type, const float shape) noexcept
+{
+    curve.setType(type, shape);
+    repaint();
+}
+
+void NanoMeter::setBallistics(const float attack, const float release, const float hold,
+                              const float holdRelease) noexcept
+{
+    attackTime = std::max(0.0f, attack);
+    releaseTime = std::max(0.0f, release);
+    holdTime = std::max(0.0f, hold);
+    holdReleaseTime = std::max(0.0f, holdRelease);
+}
+
+void NanoMeter::setColors(const Color &background, const Color &peak, const Color &rms, const Color &hold) noexcept
+{
+    backgroundColor = background;
+    peakColor = peak;
+    rmsColor = rms;
+    holdColor = hold;
+    repaint();
+}
+
+void NanoMeter::setChannelGap(const float gap) noexcept
+{
+    channelGap = std::max(0.0f, gap);
+    repaint();
+}
+
+void NanoMeter::setRefreshInterval(const uint intervalInMs)
+{
+    if (idleRegistered)
+    {
+        getWindow().removeIdleCallback(this);
+        idleRegistered = false;
+    }
+
+    // the next callback starts timing afresh
+    lastUpdate = 0.0;
+
+    if (intervalInMs != 0)
+        idleRegistered = getWindow().addIdleCallback(this, intervalInMs);
+}
+
+bool NanoMeter::update(const double deltaTime) noexcept
+{
+    const uint count = 2 * numChannels;
+    float *const target = targets.data();
+    float *const level = levels.data();
+
+    // highest level of every frame since the last update, silence if the DSP sent nothing
+    std::fill(target, target + count, 0.0f);
+
+    while (const float *const frame = queue.front())
+    {
+        for (uint i = 0; i < count; ++i)
+            target[i] = std::max(target[i], std::fabs(frame[i]));
+
+        queue.pop();
+    }
+
+    // amplitude to dB, then to display position
+    for (uint i = 0; i < count; ++i)
+        target[i] = 20.0f * std::log10(std::max(target[i], 1e-9f));
+
+    curve.normalize(target, target, count);
+
+    for (uint i = 0; i < count; ++i)
+        target[i] = std::max(0.0f, std::min(1.0f, target[i]));
+
+    // ballistics, branch free so the passes vectorize
+    const float dt = static_cast<float>(deltaTime);
+    const float attack = getCoefficient(attackTime, dt);
+    const float release = getCoefficient(releaseTime, dt);
+    const float holdFall = holdReleaseTime > 0.0f ? dt * 1000.0f / holdReleaseTime : 1.0f;
+    const float holdReset = holdTime * 0.001f;
+    float maxDelta = smoothLevels(target, level, count, attack, release);
+
+    float *const hold = holds.data();
+    float *const holdLeft = holdTimes.data();
+
+    for (uint i = 0; i < numChannels; ++i)
+    {
+        const float oldHold = hold[i];
+        const bool newPeak = target[i] >= oldHold;
+        const float left = holdLeft[i] - dt;
+        const float falling = left > 0.0f ? oldHold : std::max(level[i], oldHold - holdFall);
+
+        holdLeft[i] = newPeak ? holdReset : left;
+        hold[i] = newPeak ? target[i] : falling;
+        maxDelta = std::max(maxDelta, std::fabs(hold[i] - oldHold));
+    }
+
+    if (!isVisibleChange(maxDelta, getHeight()))
+        return false;
+
+    repaint();
+    return true;
+}
+
+const float *NanoMeter::getPeakLevels() const noexcept
+{
+    return levels.data();
+}
+
+const float *NanoMeter::getRmsLevels() const noexcept
+{
+    return levels.data() + numChannels;
+}
+
+const float *NanoMeter::getHoldLevels() const noexcept
+{
+    return holds.data();
+}
+
+void NanoMeter::idleCallback()
+{
+    const double now = getCurrentTime();
+
+    if (lastUpdate > 0.0)
+        update(now - lastUpdate);
+
+    lastUpdate = now;
+}
+
+void NanoMeter::addBars(const float *const values, const float thickness)
+{
+    const float width = static_cast<float>(getWidth());
+    const float height = static_cast<float>(getHeight());
+    const float barWidth = (width - channelGap * static_cast<float>(numChannels - 1)) / static_cast<float>(numChannels);
+
+    for (uint i = 0; i < numChannels; ++i)
+    {
+        const float top = height - values[i] * height;
+        const float barHeight = thickness > 0.0f ? thickness : height - top;
+
+        if (barHeight > 0.0f && values[i] > 0.0f)
+            rect(static_cast<float>(i) * (barWidth + channelGap), top, barWidth, barHeight);
+    }
+}
+
+void NanoMeter::onNanoDisplay()
+{
+    if (numChannels == 0)
+        return;
+
+    beginPath();
+    rect(0.0f, 0.0f, static_cast<float>(getWidth()), static_cast<float>(getHeight()));
+    fillColor(backgroundColor);
+    fill();
+
+    // one path per colour for all channels, peaks behind the RMS bars
+    beginPath();
+    addBars(getPeakLevels(), 0.0f);
+    fillColor(peakColor);
+    fill();
+
+    beginPath();
+    addBars(getRmsLevels(), 0.0f);
+    fillColor(rmsColor);
+    fill();
+
+    beginPath();
+    addBars(getHoldLevels(), 2.0f);
+    fillColor(holdColor);
+    fill();
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -4,6 +4,7 @@
 */
 
 #include "NanoRadio.hpp"
+#include "EventRecorder.hpp"
 
 START_NAMESPACE_DGL
 
@@ -16,7 +17,13 @@ NanoRadio::NanoRadio(Widget *const parent, RadioEventHandler::Callback *cb)
 
 bool NanoRadio::onMouse(const MouseEvent &ev)
 {
+    EventRecorder::recordMouse(this, ev);
     return RadioEventHandler::mouseEvent(ev);
 }
 
+void NanoRadio::repaintValueArea(const Rectangle<double> &area)
+{
+    repaintWidgetArea(this, area);
+}
+
 END_NAMESPACE_DISTRHO
@@ -4,24 +4,82 @@
 */
 
 #include "NanoSlider.hpp"
+#include "EventRecorder.hpp"
+#include "Window.hpp"
 
 START_NAMESPACE_DGL
 
 NanoSlider::NanoSlider(Widget *const parent, SliderEventHandler::Callback *const cb)
     : NanoWidget(parent),
-      SliderEventHandler(this)
+      SliderEventHandler(this),
+      filmstrip(nullptr),
+      idleRegistered(false)
 {
     SliderEventHandler::setCallback(cb);
 }
 
+NanoSlider::~NanoSlider()
+{
+    if (idleRegistered)
+        getWindow().removeIdleCallback(this);
+}
+
+void NanoSlider::setMotionCoalescing(const uint frameIntervalInMs)
+{
+    SliderEventHandler::setMotionCoalescing(frameIntervalInMs);
+
+    if (idleRegistered)
+    {
+        getWindow().removeIdleCallback(this);
+        idleRegistered = false;
+    }
+
+    if (frameIntervalInMs != 0)
+        idleRegistered = getWindow().addIdleCallback(this, frameIntervalInMs);
+}
+
+void NanoSlider::idleCallback()
+{
+    SliderEventHandler::flushMotion();
+}
+
 bool NanoSlider::onMouse(const MouseEvent &ev)
 {
+    EventRecorder::recordMouse(this, ev);
     return SliderEventHandler::mouseEvent(ev);
 }
 
 bool NanoSlider::onMotion(const MotionEvent &ev)
 {
+    EventRecorder::recordMotion(this, ev);
     return SliderEventHandler::motionEvent(ev);
 }
 
+void NanoSlider::repaintValueArea(const Rectangle<double> &area)
+{
+    repaintWidgetArea(this, area);
+}
+
+void NanoSlider::setFilmstrip(Filmstrip *const newFilmstrip) noexcept
+{
+    filmstrip = newFilmstrip;
+    repaint();
+}
+
+bool NanoSlider::drawFilmstrip()
+{
+    if (filmstrip == nullptr)
+        return false;
+
+    const TopLevelWidget *const topLevelWidget = getTopLevelWidget();
+    const double scaleFactor = topLevelWidget != nullptr ? topLevelWidget->getScaleFactor() : 1.0;
+
+    // frames run along the slider, like the thumb
+    const float position = SliderEventHandler::getNormalizedValue();
+
+    filmstrip->draw(*this, Rectangle<double>(0.0, 0.0, getWidth(), getHeight()),
+                    isInverted() ? 1.0f - position : position, scaleFactor);
+    return true;
+}
+
 END_NAMESPACE_DGL
@@ -0,0 +1,354 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#include "NanoSpectrum.hpp"
+#include "Window.hpp"
+#include "Helpers.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+// 4 independent accumulators, so the loops vectorize without reordering a single chain
+static inline float reduceMax(const float *const values, const uint count) noexcept
+{
+    float m0 = 0.0f, m1 = 0.0f, m2 = 0.0f, m3 = 0.0f;
+    uint i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        m0 = std::max(m0, values[i]);
+        m1 = std::max(m1, values[i + 1]);
+        m2 = std::max(m2, values[i + 2]);
+        m3 = std::max(m3, values[i + 3]);
+    }
+
+    for (; i < count; ++i)
+        m0 = std::max(m0, values[i]);
+
+    return std::max(std::max(m0, m1), std::max(m2, m3));
+}
+
+static inline float reduceSum(const float *const values, const uint count) noexcept
+{
+    float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+    uint i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        s0 += values[i];
+        s1 += values[i + 1];
+        s2 += values[i + 2];
+        s3 += values[i + 3];
+    }
+
+    for (; i < count; ++i)
+        s0 += values[i];
+
+    return (s0 + s1) + (s2 + s3);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+NanoSpectrum::NanoSpectrum(Widget *const parent, const uint bins, const uint queueCapacity)
+    : NanoWidget(parent),
+      numBins(std::max(2u, bins)),
+      queue(std::max(2u, bins), queueCapacity),
+      frequencyCurve(),
+      levelCurve(),
+      reduction(kReductionMax),
+      magnitudes(std::max(2u, bins), 0.0f),
+      sampleRate(48000.0),
+      tableDirty(true),
+      attackTime(0.0f),
+      releaseTime(150.0f),
+      peakReleaseTime(3000.0f),
+      lastUpdate(0.0),
+      idleRegistered(false),
+      backgroundColor(0.1f, 0.1f, 0.1f),
+      areaColor(0.2f, 0.5f, 0.8f, 0.5f),
+      lineColor(0.4f, 0.7f, 1.0f),
+      peakColor(0.9f, 0.9f, 0.9f, 0.6f)
+{
+    frequencyCurve.setRange(20.0f, 20000.0f);
+    frequencyCurve.setType(ValueCurve::kCurveLog);
+    levelCurve.setRange(-90.0f, 0.0f);
+    setRefreshInterval(16);
+}
+
+NanoSpectrum::~NanoSpectrum()
+{
+    if (idleRegistered)
+        getWindow().removeIdleCallback(this);
+}
+
+uint NanoSpectrum::getNumBins() const noexcept
+{
+    return numBins;
+}
+
+bool NanoSpectrum::pushMagnitudes(const float *const frame) noexcept
+{
+    DISTRHO_SAFE_ASSERT_RETURN(frame != nullptr, false);
+
+    return queue.push(frame);
+}
+
+void NanoSpectrum::setSampleRate(const double rate) noexcept
+{
+    DISTRHO_SAFE_ASSERT_RETURN(rate > 0.0, );
+
+    sampleRate = rate;
+    tableDirty = true;
+}
+
+void NanoSpectrum::setFrequencyRange(const float minHz, const float maxHz) noexcept
+{
+    DISTRHO_SAFE_ASSERT_RETURN(minHz > 0.0f && maxHz > minHz, );
+
+    frequencyCurve.setRange(minHz, maxHz);
+    tableDirty = true;
+}
+
+void NanoSpectrum::setLevelRange(const float minDb, const float maxDb) noexcept
+{
+    DISTRHO_SAFE_ASSERT_RETURN(maxDb > minDb, );
+
+    levelCurve.setRange(minDb, maxDb);
+}
+
+void NanoSpectrum::setReduction(const Reduction newReduction) noexcept
+{
+    reduction = newReduction;
+}
+
+void NanoSpectrum::setSmoothing(const float attack, const float release) noexcept
+{
+    attackTime = std::max(0.0f, attack);
+    releaseTime = std::max(0.0f, release);
+}
+
+void NanoSpectrum::setPeakRelease(const float peakRelease) noexcept
+{
+    peakReleaseTime = std::max(0.0f, peakRelease);
+}
+
+void NanoSpectrum::setColors(const Color &background, const Color &area, const Color &line, const Color &peak) noexcept
+{
+    backgroundColor = background;
+    areaColor = area;
+    lineColor = line;
+    peakColor = peak;
+    repaint();
+}
+
+void NanoSpectrum::setRefreshInterval(const uint intervalInMs)
+{
+    if (idleRegistered)
+    {
+        getWindow().removeIdleCallback(this);
+        idleRegistered = false;
+    }
+
+    // the next callback starts timing afresh
+    lastUpdate = 0.0;
+
+    if (intervalInMs != 0)
+        idleRegistered = getWindow().addIdleCallback(this, intervalInMs);
+}
+
+void NanoSpectrum::buildTable()
+{
+    const uint numColumns = getWidth();
+    const double binWidth = sampleRate * 0.5 / static_cast<double>(numBins - 1);
+    const uint lastBin = numBins - 1;
+
+    // columns now cover other frequencies, what they showed before no longer applies
+    table.resize(numColumns);
+    targets.assign(numColumns, 0.0f);
+    levels.assign(numColumns, 0.0f);
+    peaks.assign(numColumns, 0.0f);
+
+    for (uint c = 0; c < numColumns; ++c)
+    {
+        // bins whose centers fall within the frequency span of this column
+        const double b0 = frequencyCurve.denormalize(static_cast<float>(c) / numColumns) / binWidth;
+        const double b1 = frequencyCurve.denormalize(static_cast<float>(c + 1) / numColumns) / binWidth;
+        const uint first = std::min(lastBin, static_cast<uint>(std::ceil(b0)));
+        const uint last = std::min(numBins, static_cast<uint>(std::ceil(b1)));
+
+        Column &column(table[c]);
+
+        if (last > first)
+        {
+            column.first = first;
+            column.count = last - first;
+            column.fraction = 0.0f;
+        }
+        else
+        {
+            const double center = std::min(static_cast<double>(lastBin) - 0.001, (b0 + b1) * 0.5);
+            column.first = static_cast<uint32_t>(center);
+            column.count = 0;
+            column.fraction = static_cast<float>(center - column.first);
+        }
+    }
+
+    tableDirty = false;
+}
+
+bool NanoSpectrum::update(const double deltaTime)
+{
+    if (tableDirty || table.size() != getWidth())
+        buildTable();
+
+    const uint numColumns = static_cast<uint>(table.size());
+
+    if (numColumns == 0)
+        return false;
+
+    // highest magnitude of every frame since the last update, the previous frame stays if none arrived
+    if (const float *frame = queue.front())
+    {
+        float *const mags = magnitudes.data();
+
+        std::copy(frame, frame + numBins, mags);
+        queue.pop();
+
+        while ((frame = queue.front()) != nullptr)
+        {
+            for (uint i = 0; i < numBins; ++i)
+                mags[i] = std::max(mags[i], frame[i]);
+
+            queue.pop();
+        }
+    }
+
+    const float *const mags = magnitudes.data();
+    const Column *const columns = table.data();
+    float *const target = targets.data();
+
+    for (uint c = 0; c < numColumns; ++c)
+    {
+        const Column &column(columns[c]);
+        const float *const bins = mags + column.first;
+
+        if (column.count == 0)
+            target[c] = bins[0] + (bins[1] - bins[0]) * column.fraction;
+        else if (reduction == kReductionMax)
+            target[c] = reduceMax(bins, column.count);
+        else
+            target[c] = reduceSum(bins, column.count) / static_cast<float>(column.count);
+    }
+
+    // magnitude to dB, then to display position
+    for (uint c = 0; c < numColumns; ++c)
+        target[c] = 20.0f * std::log10(std::max(std::fabs(target[c]), 1e-9f));
+
+    levelCurve.normalize(target, target, numColumns);
+
+    for (uint c = 0; c < numColumns; ++c)
+        target[c] = std::max(0.0f, std::min(1.0f, target[c]));
+
+    // smoothing and falling peaks, branch free so the passes vectorize
+    const float dt = static_cast<float>(deltaTime);
+    const float attack = getCoefficient(attackTime, dt);
+    const float release = getCoefficient(releaseTime, dt);
+    const float peakFall = peakReleaseTime > 0.0f ? dt * 1000.0f / peakReleaseTime : 1.0f;
+    float *const level = levels.data();
+    float *const peak = peaks.data();
+    float maxDelta = smoothLevels(target, level, numColumns, attack, release);
+
+    for (uint c = 0; c < numColumns; ++c)
+    {
+        const float newPeak = std::max(level[c], peak[c] - peakFall);
+
+        maxDelta = std::max(maxDelta, std::fabs(newPeak - peak[c]));
+        peak[c] = newPeak;
+    }
+
+    if (!isVisibleChange(maxDelta, getHeight()))
+        return false;
+
+    repaint();
+    return true;
+}
+
+uint NanoSpectrum::getNumColumns() const noexcept
+{
+    return static_cast<uint>(table.size());
+}
+
+const float *NanoSpectrum::getLevels() const noexcept
+{
+    return levels.data();
+}
+
+const float *NanoSpectrum::getPeaks() const noexcept
+{
+    return peaks.data();
+}
+
+void NanoSpectrum::idleCallback()
+{
+    const double now = getCurrentTime();
+
+    if (lastUpdate > 0.0)
+        update(now - lastUpdate);
+
+    lastUpdate = now;
+}
+
+void NanoSpectrum::addLine(const float *const values)
+{
+    const float height = static_cast<float>(getHeight());
+    const uint numColumns = getNumColumns();
+
+    moveTo(0.5f, height - values[0] * height);
+
+    for (uint c = 1; c < numColumns; ++c)
+        lineTo(static_cast<float>(c) + 0.5f, height - values[c] * height);
+}
+
+void NanoSpectrum::onNanoDisplay()
+{
+    const float width = static_cast<float>(getWidth());
+    const float height = static_cast<float>(getHeight());
+
+    beginPath();
+    rect(0.0f, 0.0f, width, height);
+    fillColor(backgroundColor);
+    fill();
+
+    // the table follows the width in update(), skip drawing until it caught up
+    if (getNumColumns() == 0 || getNumColumns() != getWidth())
+        return;
+
+    beginPath();
+    addLine(getLevels());
+    lineTo(width, height);
+    lineTo(0.0f, height);
+    closePath();
+    fillColor(areaColor);
+    fill();
+
+    beginPath();
+    addLine(getLevels());
+    strokeColor(lineColor);
+    strokeWidth(1.0f);
+    stroke();
+
+    beginPath();
+    addLine(getPeaks());
+    strokeColor(peakColor);
+    stroke();
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
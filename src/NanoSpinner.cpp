@@ -4,6 +4,7 @@
 */
 
 #include "NanoSpinner.hpp"
+#include "EventRecorder.hpp"
 
 START_NAMESPACE_DGL
 
@@ -16,16 +17,19 @@ NanoSpinner::NanoSpinner(Widget *const parent, SpinnerEventHandler::Callback *co
 
 bool NanoSpinner::onMouse(const MouseEvent &ev)
 {
+    EventRecorder::recordMouse(this, ev);
     return SpinnerEventHandler::mouseEvent(ev);
 }
 
 bool NanoSpinner::onMotion(const MotionEvent &ev)
 {
+    EventRecorder::recordMotion(this, ev);
     return SpinnerEventHandler::motionEvent(ev);
 }
 
 bool NanoSpinner::onScroll(const ScrollEvent &ev)
 {
+    EventRecorder::recordScroll(this, ev);
     return SpinnerEventHandler::scrollEvent(ev);
 }
 
@@ -4,6 +4,7 @@
 */
 
 #include "NanoSwitch.hpp"
+#include "EventRecorder.hpp"
 
 START_NAMESPACE_DGL
 
@@ -16,6 +17,7 @@ NanoSwitch::NanoSwitch(Widget *const parent, SwitchEventHandler::Callback *const
 
 bool NanoSwitch::onMouse(const MouseEvent &ev)
 {
+    EventRecorder::recordMouse(this, ev);
     return SwitchEventHandler::mouseEvent(ev);
 }
 
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#include "NanoWidgetPanel.hpp"
+#include "EventAccess.hpp"
+
+#include <algorithm>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+// events arrive relative to the panel, children expect them relative to themselves
+template <class Event>
+static Event toChild(const Event &ev, const SubWidget *const widget)
+{
+    Event cev(ev);
+    cev.pos = Point<double>(ev.absolutePos.getX() - widget->getAbsoluteX(),
+                            ev.absolutePos.getY() - widget->getAbsoluteY());
+    return cev;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+NanoWidgetPanel::NanoWidgetPanel(Widget *const parent, const uint size)
+    : NanoSubWidget(parent),
+      cellSize(std::max(1u, size)),
+      numColumns(0),
+      numRows(0),
+      indexDirty(true),
+      capturing(nullptr),
+      hovered(nullptr)
+{
+}
+
+void NanoWidgetPanel::addWidget(SubWidget *const widget)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(widget != nullptr, );
+
+    Child child;
+    child.widget = widget;
+    children.push_back(child);
+    indexDirty = true;
+}
+
+void NanoWidgetPanel::removeWidget(SubWidget *const widget)
+{
+    for (std::vector<Child>::iterator it = children.begin(); it != children.end(); ++it)
+    {
+        if (it->widget == widget)
+        {
+            children.erase(it);
+            break;
+        }
+    }
+
+    if (capturing == widget)
+        capturing = nullptr;
+    if (hovered == widget)
+        hovered = nullptr;
+
+    indexDirty = true;
+}
+
+void NanoWidgetPanel::updateIndex() noexcept
+{
+    indexDirty = true;
+}
+
+void NanoWidgetPanel::rebuildIndex()
+{
+    indexDirty = false;
+    numColumns = (getWidth() + cellSize - 1) / cellSize;
+    numRows = (getHeight() + cellSize - 1) / cellSize;
+
+    // keep the per-cell vectors around, so their memory is reused
+    cells.resize(numColumns * numRows);
+
+    for (std::vector<uint> &cell : cells)
+        cell.clear();
+
+    const int panelX = getAbsoluteX();
+    const int panelY = getAbsoluteY();
+
+    for (uint i = 0; i < children.size(); ++i)
+    {
+        Child &child(children[i]);
+        const double x = child.widget->getAbsoluteX() - panelX;
+        const double y = child.widget->getAbsoluteY() - panelY;
+        const double w = child.widget->getWidth();
+        const double h = child.widget->getHeight();
+
+        child.area = Rectangle<double>(x, y, w, h);
+
+        if (numColumns == 0 || numRows == 0 || x + w <= 0.0 || y + h <= 0.0)
+            continue;
+
+        const uint firstColumn = static_cast<uint>(std::max(0.0, x)) / cellSize;
+        const uint firstRow = static_cast<uint>(std::max(0.0, y)) / cellSize;
+        const uint lastColumn = std::min(numColumns - 1, static_cast<uint>(x + w - 1.0) / cellSize);
+        const uint lastRow = std::min(numRows - 1, static_cast<uint>(y + h - 1.0) / cellSize);
+
+        for (uint row = firstRow; row <= lastRow; ++row)
+            for (uint column = firstColumn; column <= lastColumn; ++column)
+                cells[row * numColumns + column].push_back(i);
+    }
+}
+
+SubWidget *NanoWidgetPanel::getWidgetAt(const double x, const double y)
+{
+    if (indexDirty)
+        rebuildIndex();
+
+    if (x < 0.0 || y < 0.0)
+        return nullptr;
+
+    const uint column = static_cast<uint>(x) / cellSize;
+    const uint row = static_cast<uint>(y) / cellSize;
+
+    if (column >= numColumns || row >= numRows)
+        return nullptr;
+
+    const std::vector<uint> &cell(cells[row * numColumns + column]);
+
+    // last added is on top
+    for (std::vector<uint>::const_reverse_iterator it = cell.rbegin(); it != cell.rend(); ++it)
+    {
+        const Child &child(children[*it]);
+
+        if (child.widget->isVisible() && child.area.contains(x, y))
+            return child.widget;
+    }
+
+    return nullptr;
+}
+
+SubWidget *NanoWidgetPanel::getCapturingWidget() const noexcept
+{
+    return capturing;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+void NanoWidgetPanel::onNanoDisplay()
+{
+}
+
+bool NanoWidgetPanel::onMouse(const MouseEvent &ev)
+{
+    if (capturing != nullptr)
+    {
+        SubWidget *const widget = capturing;
+
+        if (!ev.press)
+            capturing = nullptr;
+
+        return EventAccess::mouse(widget, toChild(ev, widget));
+    }
+
+    SubWidget *const widget = getWidgetAt(ev.pos.getX(), ev.pos.getY());
+
+    if (widget == nullptr)
+        return false;
+
+    if (!EventAccess::mouse(widget, toChild(ev, widget)))
+        return false;
+
+    if (ev.press)
+        capturing = widget;
+
+    return true;
+}
+
+bool NanoWidgetPanel::onMotion(const MotionEvent &ev)
+{
+    if (capturing != nullptr)
+        return EventAccess::motion(capturing, toChild(ev, capturing));
+
+    SubWidget *const widget = getWidgetAt(ev.pos.getX(), ev.pos.getY());
+
+    // let the previous child see the cursor leave
+    if (hovered != nullptr && hovered != widget)
+        EventAccess::motion(hovered, toChild(ev, hovered));
+
+    hovered = widget;
+
+    return widget != nullptr && EventAccess::motion(widget, toChild(ev, widget));
+}
+
+bool NanoWidgetPanel::onScroll(const ScrollEvent &ev)
+{
+    SubWidget *const widget = capturing != nullptr ? capturing : getWidgetAt(ev.pos.getX(), ev.pos.getY());
+
+    return widget != nullptr && EventAccess::scroll(widget, toChild(ev, widget));
+}
+
+void NanoWidgetPanel::onResize(const ResizeEvent &ev)
+{
+    indexDirty = true;
+    NanoSubWidget::onResize(ev);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
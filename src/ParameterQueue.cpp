@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#include "ParameterQueue.hpp"
+#include "Helpers.hpp"
+
+#include <algorithm>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+ParameterQueue::ParameterQueue(const uint32_t capacity)
+    : buffer(new Event[roundToPowerOf2(capacity)]),
+      mask(roundToPowerOf2(capacity) - 1),
+      writeIndex(0),
+      readIndex(0)
+{
+}
+
+ParameterQueue::~ParameterQueue()
+{
+    delete[] buffer;
+}
+
+bool ParameterQueue::push(const uint32_t parameter, const float value, const uint32_t time) noexcept
+{
+    const uint32_t write = writeIndex.load(std::memory_order_relaxed);
+
+    if (write - readIndex.load(std::memory_order_acquire) > mask)
+        return false;
+
+    Event &event(buffer[write & mask]);
+    event.parameter = parameter;
+    event.value = value;
+    event.time = time;
+
+    writeIndex.store(write + 1, std::memory_order_release);
+    return true;
+}
+
+bool ParameterQueue::pop(Event &event) noexcept
+{
+    const uint32_t read = readIndex.load(std::memory_order_relaxed);
+
+    if (read == writeIndex.load(std::memory_order_acquire))
+        return false;
+
+    event = buffer[read & mask];
+
+    readIndex.store(read + 1, std::memory_order_release);
+    return true;
+}
+
+uint32_t ParameterQueue::drain(Event *const events, const uint32_t maxEvents) noexcept
+{
+    const uint32_t read = readIndex.load(std::memory_order_relaxed);
+    const uint32_t available = writeIndex.load(std::memory_order_acquire) - read;
+    const uint32_t count = std::min(available, maxEvents);
+
+    for (uint32_t i = 0; i < count; ++i)
+        events[i] = buffer[(read + i) & mask];
+
+    readIndex.store(read + count, std::memory_order_release);
+    return count;
+}
+
+bool ParameterQueue::isEmpty() const noexcept
+{
+    return readIndex.load(std::memory_order_acquire) == writeIndex.load(std::memory_order_acquire);
+}
+
+uint32_t ParameterQueue::getCapacity() const noexcept
+{
+    return mask + 1;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#include "PresetMorph.hpp"
+#include "ValueTransaction.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+PresetMorph::PresetMorph()
+{
+}
+
+uint PresetMorph::add(SliderEventHandler *const slider, SpinnerEventHandler *const spinner)
+{
+    Target target;
+    target.slider = slider;
+    target.spinner = spinner;
+    targets.push_back(target);
+
+    const float normalized = slider != nullptr ? slider->getNormalizedValue() : spinner->getNormalizedValue();
+    snapshotA.push_back(normalized);
+    snapshotB.push_back(normalized);
+    morphed.push_back(normalized);
+
+    return static_cast<uint>(targets.size() - 1);
+}
+
+uint PresetMorph::addSlider(SliderEventHandler *const slider)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(slider != nullptr, 0);
+
+    return add(slider, nullptr);
+}
+
+uint PresetMorph::addSpinner(SpinnerEventHandler *const spinner)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(spinner != nullptr, 0);
+
+    return add(nullptr, spinner);
+}
+
+uint PresetMorph::getNumHandlers() const noexcept
+{
+    return static_cast<uint>(targets.size());
+}
+
+void PresetMorph::capture(const Snapshot snapshot)
+{
+    float *const values = snapshot == kSnapshotA ? snapshotA.data() : snapshotB.data();
+
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+        const Target &target(targets[i]);
+        values[i] = target.slider != nullptr ? target.slider->getNormalizedValue()
+                                             : target.spinner->getNormalizedValue();
+    }
+}
+
+void PresetMorph::setSnapshot(const Snapshot snapshot, const float *const normalizedValues)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(normalizedValues != nullptr, );
+
+    std::vector<float> &values(snapshot == kSnapshotA ? snapshotA : snapshotB);
+    std::copy(normalizedValues, normalizedValues + values.size(), values.begin());
+}
+
+const float *PresetMorph::getSnapshot(const Snapshot snapshot) const noexcept
+{
+    return snapshot == kSnapshotA ? snapshotA.data() : snapshotB.data();
+}
+
+uint PresetMorph::morph(float position, const bool sendCallbacks)
+{
+    position = clamp(position, 1.0f, 0.0f);
+
+    const uint count = static_cast<uint>(targets.size());
+    const float *const a = snapshotA.data();
+    const float *const b = snapshotB.data();
+    float *const out = morphed.data();
+
+    // plain loop over contiguous arrays, vectorized by the compiler
+    for (uint i = 0; i < count; ++i)
+        out[i] = a[i] + position * (b[i] - a[i]);
+
+    // join a transaction already running, e.g. a preset load, otherwise run our own
+    ValueTransaction transaction;
+    const bool ownTransaction = ValueTransaction::getCurrent() == nullptr;
+
+    if (ownTransaction)
+        transaction.begin();
+
+    uint changed = 0;
+
+    for (uint i = 0; i < count; ++i)
+    {
+        const Target &target(targets[i]);
+
+        // stepped by the handlers' own rule, then clamped by their setValue
+        if (target.slider != nullptr)
+        {
+            const float oldValue = target.slider->getValue();
+            const float value = snapToStep(target.slider->getCurve().denormalize(out[i]), target.slider->getStep());
+
+            target.slider->setValue(value, sendCallbacks);
+
+            if (d_isNotEqual(oldValue, target.slider->getValue()))
+                ++changed;
+        }
+        else
+        {
+            const float oldValue = target.spinner->getValue();
+            const float value = snapToStep(target.spinner->getCurve().denormalize(out[i]), target.spinner->getStep());
+
+            target.spinner->setValue(value, sendCallbacks);
+
+            if (d_isNotEqual(oldValue, target.spinner->getValue()))
+                ++changed;
+        }
+    }
+
+    if (ownTransaction)
+        transaction.commit(sendCallbacks);
+
+    return changed;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
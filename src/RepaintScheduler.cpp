@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#include "RepaintScheduler.hpp"
+#include "ExtraEventHandlers.hpp"
+#include "Helpers.hpp"
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+static inline uint hashWidget(const SubWidget *const widget) noexcept
+{
+    return static_cast<uint>((reinterpret_cast<uintptr_t>(widget) >> 4) * 2654435761u);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+RepaintScheduler::RepaintScheduler(const double maxFrameRate)
+    : frameInterval(0.0),
+      lastFlush(0.0),
+      policy(kRepaintAlways),
+      stats(),
+      slots(64, 0)
+{
+    setMaxFrameRate(maxFrameRate);
+    pending.reserve(32);
+}
+
+void RepaintScheduler::setMaxFrameRate(const double maxFrameRate) noexcept
+{
+    DISTRHO_SAFE_ASSERT_RETURN(maxFrameRate > 0.0, );
+
+    frameInterval = 1.0 / maxFrameRate;
+}
+
+void RepaintScheduler::setPolicy(const Policy newPolicy) noexcept
+{
+    policy = newPolicy;
+}
+
+uint RepaintScheduler::findSlot(const SubWidget *const widget) const noexcept
+{
+    const uint mask = static_cast<uint>(slots.size() - 1);
+    uint slot = hashWidget(widget) & mask;
+
+    // there is always at least one empty slot, see growSlots()
+    while (slots[slot] != 0 && pending[slots[slot] - 1].widget != widget)
+        slot = (slot + 1) & mask;
+
+    return slot;
+}
+
+void RepaintScheduler::growSlots()
+{
+    slots.assign(slots.size() * 2, 0);
+
+    for (uint i = 0; i < pending.size(); ++i)
+        slots[findSlot(pending[i].widget)] = i + 1;
+}
+
+void RepaintScheduler::markDirty(SubWidget *const widget, const Rectangle<double> &area,
+                                 AreaRepainter *const repainter)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(widget != nullptr, );
+
+    ++stats.requests;
+
+    const uint slot = findSlot(widget);
+
+    if (slots[slot] != 0)
+    {
+        Entry &entry(pending[slots[slot] - 1]);
+        ++stats.coalesced;
+
+        if (entry.full)
+            return;
+
+        if (!area.isValid())
+        {
+            entry.full = true;
+            return;
+        }
+
+        const double x1 = std::min(entry.area.getX(), area.getX());
+        const double y1 = std::min(entry.area.getY(), area.getY());
+        const double x2 = std::max(entry.area.getX() + entry.area.getWidth(), area.getX() + area.getWidth());
+        const double y2 = std::max(entry.area.getY() + entry.area.getHeight(), area.getY() + area.getHeight());
+        entry.area = Rectangle<double>(x1, y1, x2 - x1, y2 - y1);
+        return;
+    }
+
+    Entry entry;
+    entry.widget = widget;
+    entry.repainter = repainter;
+    entry.area = area;
+    entry.full = !area.isValid();
+
+    pending.push_back(entry);
+    slots[slot] = static_cast<uint>(pending.size());
+
+    // keep the table at most half full
+    if (pending.size() * 2 > slots.size())
+        growSlots();
+}
+
+void RepaintScheduler::cancel(SubWidget *const widget) noexcept
+{
+    const uint slot = findSlot(widget);
+
+    if (slots[slot] == 0)
+        return;
+
+    pending[slots[slot] - 1].widget = nullptr;
+}
+
+uint RepaintScheduler::flush()
+{
+    uint count = 0;
+
+    for (const Entry &entry : pending)
+    {
+        if (entry.widget == nullptr)
+            continue;
+
+        if (policy == kRepaintWhenVisible && !entry.widget->isVisible())
+        {
+            ++stats.skippedHidden;
+            continue;
+        }
+
+        if (entry.full)
+            entry.widget->repaint();
+        else if (entry.repainter != nullptr)
+            entry.repainter->repaintArea(entry.area);
+        else
+            repaintWidgetArea(entry.widget, entry.area);
+
+        ++count;
+    }
+
+    pending.clear();
+    std::fill(slots.begin(), slots.end(), 0u);
+
+    stats.repaints += count;
+    ++stats.flushes;
+    lastFlush = getCurrentTime();
+
+    return count;
+}
+
+const RepaintScheduler::Stats &RepaintScheduler::getStats() const noexcept
+{
+    return stats;
+}
+
+void RepaintScheduler::resetStats() noexcept
+{
+    stats = Stats();
+}
+
+void RepaintScheduler::idleCallback()
+{
+    if (pending.empty() || getCurrentTime() - lastFlush < frameInterval)
+        return;
+
+    flush();
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -0,0 +1,357 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#include "StateSerializer.hpp"
+#include "ValueTransaction.hpp"
+
+#include <cmath>
+#include <cstring>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+static const uint32_t kMagic = 0x534c4744; // "DGLS"
+static const size_t kHeaderSize = 3 * sizeof(uint32_t);
+
+// the tag byte plus the fields, no padding
+static const size_t kSwitchRecordSize = 1 + 1;
+static const size_t kSliderRecordSize = 1 + 5 * sizeof(float) + 1 + sizeof(float) + 2;
+static const size_t kSpinnerRecordSize = 1 + 4 * sizeof(float) + 1 + sizeof(float);
+static const size_t kRadioRecordSize = 1 + 3 * sizeof(float);
+
+// fixed size cursors, bounds are checked once for the whole buffer
+struct Writer
+{
+    uint8_t *pos;
+
+    void putByte(const uint8_t value) noexcept
+    {
+        *pos++ = value;
+    }
+
+    void putFloat(const float value) noexcept
+    {
+        std::memcpy(pos, &value, sizeof(float));
+        pos += sizeof(float);
+    }
+
+    void putUInt(const uint32_t value) noexcept
+    {
+        std::memcpy(pos, &value, sizeof(uint32_t));
+        pos += sizeof(uint32_t);
+    }
+};
+
+struct Reader
+{
+    const uint8_t *pos;
+
+    uint8_t getByte() noexcept
+    {
+        return *pos++;
+    }
+
+    float getFloat() noexcept
+    {
+        float value;
+        std::memcpy(&value, pos, sizeof(float));
+        pos += sizeof(float);
+        return value;
+    }
+
+    uint32_t getUInt() noexcept
+    {
+        uint32_t value;
+        std::memcpy(&value, pos, sizeof(uint32_t));
+        pos += sizeof(uint32_t);
+        return value;
+    }
+};
+
+// table curves are not saved, their values are part of the widget design
+static inline bool isValidCurve(const uint8_t curve) noexcept
+{
+    return curve < ValueCurve::kCurveTable;
+}
+
+// reads `count` floats, false if any of them is NaN or infinite
+static bool readFinite(Reader &reader, float *const values, const uint count) noexcept
+{
+    bool finite = true;
+
+    for (uint i = 0; i < count; ++i)
+    {
+        values[i] = reader.getFloat();
+        finite = finite && std::isfinite(values[i]);
+    }
+
+    return finite;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+StateSerializer::StateSerializer()
+    : size(kHeaderSize)
+{
+}
+
+void StateSerializer::add(const Type type, void *const handler, const size_t recordSize)
+{
+    Entry entry;
+    entry.type = type;
+    entry.handler = handler;
+    entries.push_back(entry);
+
+    size += recordSize;
+}
+
+void StateSerializer::addSwitch(SwitchEventHandler *const handler)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(handler != nullptr, );
+
+    add(kTypeSwitch, handler, kSwitchRecordSize);
+}
+
+void StateSerializer::addSlider(SliderEventHandler *const handler)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(handler != nullptr, );
+
+    add(kTypeSlider, handler, kSliderRecordSize);
+}
+
+void StateSerializer::addSpinner(SpinnerEventHandler *const handler)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(handler != nullptr, );
+
+    add(kTypeSpinner, handler, kSpinnerRecordSize);
+}
+
+void StateSerializer::addRadio(RadioEventHandler *const handler)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(handler != nullptr, );
+
+    add(kTypeRadio, handler, kRadioRecordSize);
+}
+
+uint StateSerializer::getNumHandlers() const noexcept
+{
+    return static_cast<uint>(entries.size());
+}
+
+void StateSerializer::clear() noexcept
+{
+    entries.clear();
+    size = kHeaderSize;
+}
+
+size_t StateSerializer::getSize() const noexcept
+{
+    return size;
+}
+
+size_t StateSerializer::write(uint8_t *const data, const size_t dataSize) const noexcept
+{
+    DISTRHO_SAFE_ASSERT_RETURN(data != nullptr, 0);
+    DISTRHO_SAFE_ASSERT_RETURN(dataSize >= size, 0);
+
+    Writer writer = { data };
+    writer.putUInt(kMagic);
+    writer.putUInt(kVersion);
+    writer.putUInt(static_cast<uint32_t>(entries.size()));
+
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        const Entry &entry(entries[i]);
+        writer.putByte(static_cast<uint8_t>(entry.type));
+
+        switch (entry.type)
+        {
+        case kTypeSwitch:
+        {
+            SwitchEventHandler::Snapshot state;
+            static_cast<const SwitchEventHandler *>(entry.handler)->saveState(state);
+            writer.putByte(state.down ? 1 : 0);
+            break;
+        }
+        case kTypeSlider:
+        {
+            SliderEventHandler::Snapshot state;
+            static_cast<const SliderEventHandler *>(entry.handler)->saveState(state);
+            DISTRHO_SAFE_ASSERT_RETURN(isValidCurve(state.curve), 0);
+            writer.putFloat(state.value);
+            writer.putFloat(state.valueDef);
+            writer.putFloat(state.minimum);
+            writer.putFloat(state.maximum);
+            writer.putFloat(state.step);
+            writer.putByte(static_cast<uint8_t>(state.curve));
+            writer.putFloat(state.curveShape);
+            writer.putByte(state.usingDefault ? 1 : 0);
+            writer.putByte(state.inverted ? 1 : 0);
+            break;
+        }
+        case kTypeSpinner:
+        {
+            SpinnerEventHandler::Snapshot state;
+            static_cast<const SpinnerEventHandler *>(entry.handler)->saveState(state);
+            DISTRHO_SAFE_ASSERT_RETURN(isValidCurve(state.curve), 0);
+            writer.putFloat(state.value);
+            writer.putFloat(state.minimum);
+            writer.putFloat(state.maximum);
+            writer.putFloat(state.step);
+            writer.putByte(static_cast<uint8_t>(state.curve));
+            writer.putFloat(state.curveShape);
+            break;
+        }
+        case kTypeRadio:
+        {
+            RadioEventHandler::Snapshot state;
+            static_cast<const RadioEventHandler *>(entry.handler)->saveState(state);
+            writer.putFloat(state.value);
+            writer.putFloat(state.minimum);
+            writer.putFloat(state.maximum);
+            break;
+        }
+        }
+    }
+
+    return size;
+}
+
+void StateSerializer::write(std::vector<uint8_t> &buffer) const
+{
+    buffer.resize(size);
+
+    if (write(buffer.data(), size) == 0)
+        buffer.clear();
+}
+
+bool StateSerializer::read(const uint8_t *const data, const size_t dataSize, const bool sendCallbacks)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(data != nullptr, false);
+
+    // the record sizes only depend on the handler types, so a matching size and header
+    // plus matching tags mean every record can be read without further bounds checks
+    if (dataSize != size)
+        return false;
+
+    Reader reader = { data };
+
+    if (reader.getUInt() != kMagic || reader.getUInt() != kVersion)
+        return false;
+    if (reader.getUInt() != entries.size())
+        return false;
+
+    const uint8_t *const records = reader.pos;
+
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        const Entry &entry(entries[i]);
+
+        if (reader.getByte() != entry.type)
+            return false;
+
+        // everything restoreState() would reject is checked here, before any handler changes
+        float values[5];
+
+        switch (entry.type)
+        {
+        case kTypeSwitch:
+            reader.pos += kSwitchRecordSize - 1;
+            break;
+        case kTypeSlider:
+            // value, default, minimum, maximum, step, then curve, shape and 2 flags
+            if (!readFinite(reader, values, 5) || !(values[3] > values[2]) || !isValidCurve(reader.getByte()))
+                return false;
+            if (!readFinite(reader, values, 1))
+                return false;
+            reader.pos += 2;
+            break;
+        case kTypeSpinner:
+            // value, minimum, maximum, step, then curve and shape
+            if (!readFinite(reader, values, 4) || !(values[2] > values[1]) || !isValidCurve(reader.getByte()))
+                return false;
+            if (!readFinite(reader, values, 1))
+                return false;
+            break;
+        case kTypeRadio:
+            // value, minimum, maximum. a radio with a single option has minimum == maximum
+            if (!readFinite(reader, values, 3) || !(values[2] >= values[1]))
+                return false;
+            break;
+        }
+    }
+
+    reader.pos = records;
+
+    // join a transaction already running, e.g. a preset load, otherwise run our own
+    ValueTransaction transaction;
+    const bool ownTransaction = ValueTransaction::getCurrent() == nullptr;
+
+    if (ownTransaction)
+        transaction.begin();
+
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        const Entry &entry(entries[i]);
+        ++reader.pos;
+
+        switch (entry.type)
+        {
+        case kTypeSwitch:
+        {
+            SwitchEventHandler::Snapshot state;
+            state.down = reader.getByte() != 0;
+            static_cast<SwitchEventHandler *>(entry.handler)->restoreState(state);
+            break;
+        }
+        case kTypeSlider:
+        {
+            SliderEventHandler::Snapshot state;
+            state.value = reader.getFloat();
+            state.valueDef = reader.getFloat();
+            state.minimum = reader.getFloat();
+            state.maximum = reader.getFloat();
+            state.step = reader.getFloat();
+            state.curve = static_cast<ValueCurve::Type>(reader.getByte());
+            state.curveShape = reader.getFloat();
+            state.usingDefault = reader.getByte() != 0;
+            state.inverted = reader.getByte() != 0;
+            static_cast<SliderEventHandler *>(entry.handler)->restoreState(state, sendCallbacks);
+            break;
+        }
+        case kTypeSpinner:
+        {
+            SpinnerEventHandler::Snapshot state;
+            state.value = reader.getFloat();
+            state.minimum = reader.getFloat();
+            state.maximum = reader.getFloat();
+            state.step = reader.getFloat();
+            state.curve = static_cast<ValueCurve::Type>(reader.getByte());
+            state.curveShape = reader.getFloat();
+            static_cast<SpinnerEventHandler *>(entry.handler)->restoreState(state, sendCallbacks);
+            break;
+        }
+        case kTypeRadio:
+        {
+            RadioEventHandler::Snapshot state;
+            state.value = reader.getFloat();
+            state.minimum = reader.getFloat();
+            state.maximum = reader.getFloat();
+            static_cast<RadioEventHandler *>(entry.handler)->restoreState(state, sendCallbacks);
+            break;
+        }
+        }
+    }
+
+    if (ownTransaction)
+        transaction.commit(sendCallbacks);
+
+    return true;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#include "UndoJournal.hpp"
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+UndoJournal::UndoJournal(const uint size, const uint mergeWindowInMs)
+    : entries(new Entry[size > 0 ? size : 1]),
+      capacity(size > 0 ? size : 1),
+      mergeWindow(mergeWindowInMs),
+      first(0),
+      count(0),
+      position(0),
+      mergeable(false)
+{
+}
+
+UndoJournal::~UndoJournal()
+{
+    delete[] entries;
+}
+
+UndoJournal::Entry &UndoJournal::at(const uint index) const noexcept
+{
+    return entries[(first + index) % capacity];
+}
+
+void UndoJournal::record(const uint32_t id, const float oldValue, const float newValue,
+                         const uint32_t time, const bool merge) noexcept
+{
+    if (d_isEqual(oldValue, newValue))
+        return;
+
+    if (merge && mergeable && position != 0 && position == count)
+    {
+        Entry &last(at(position - 1));
+
+        if (last.id == id && time - last.time <= mergeWindow)
+        {
+            last.newValue = newValue;
+            last.time = time;
+            return;
+        }
+    }
+
+    // a new change drops whatever could be redone
+    count = position;
+
+    if (count == capacity)
+    {
+        first = (first + 1) % capacity;
+        --count;
+    }
+
+    Entry &entry(at(count));
+    entry.id = id;
+    entry.oldValue = oldValue;
+    entry.newValue = newValue;
+    entry.time = time;
+
+    position = ++count;
+    mergeable = merge;
+}
+
+bool UndoJournal::canUndo() const noexcept
+{
+    return position > 0;
+}
+
+bool UndoJournal::canRedo() const noexcept
+{
+    return position < count;
+}
+
+bool UndoJournal::undo(Entry &entry) noexcept
+{
+    if (position == 0)
+        return false;
+
+    entry = at(--position);
+    mergeable = false;
+    return true;
+}
+
+bool UndoJournal::redo(Entry &entry) noexcept
+{
+    if (position == count)
+        return false;
+
+    entry = at(position++);
+    mergeable = false;
+    return true;
+}
+
+void UndoJournal::clear() noexcept
+{
+    first = count = position = 0;
+    mergeable = false;
+}
+
+uint UndoJournal::getNumEntries() const noexcept
+{
+    return count;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
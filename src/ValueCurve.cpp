@@ -0,0 +1,311 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#include "ValueCurve.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+// ln(10) / 20, converts dB to natural log of amplitude
+static const float kDecibelToLog = 0.11512925464970229f;
+
+static inline float lookup(const float *const lut, const uint size, const float position) noexcept
+{
+    const float x = std::min(std::max(position, 0.0f), 1.0f) * static_cast<float>(size);
+    const uint index = std::min(static_cast<uint>(x), size - 1);
+    const float frac = x - static_cast<float>(index);
+
+    return lut[index] + frac * (lut[index + 1] - lut[index]);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+ValueCurve::ValueCurve() noexcept
+    : type(kCurveLinear),
+      active(kCurveLinear),
+      shape(1.0f),
+      minimum(0.0f),
+      maximum(1.0f),
+      range(1.0f),
+      invRange(1.0f),
+      offset(0.0f),
+      scale(1.0f),
+      invScale(1.0f),
+      extra(1.0f)
+{
+}
+
+void ValueCurve::setRange(const float min, const float max) noexcept
+{
+    DISTRHO_SAFE_ASSERT_RETURN(max > min, );
+    DISTRHO_SAFE_ASSERT_RETURN(type != kCurveTable, );
+
+    minimum = min;
+    maximum = max;
+    update();
+}
+
+void ValueCurve::setType(const Type newType, const float newShape) noexcept
+{
+    DISTRHO_SAFE_ASSERT_RETURN(newType != kCurveTable || table.size() >= 2, );
+
+    type = newType;
+    shape = newShape;
+
+    if (type == kCurveTable)
+    {
+        minimum = table.front();
+        maximum = table.back();
+    }
+
+    update();
+}
+
+void ValueCurve::setTable(const float *const values, const uint count)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(values != nullptr && count >= 2, );
+
+    table.assign(values, values + count);
+    minimum = table.front();
+    maximum = table.back();
+    type = kCurveTable;
+    update();
+}
+
+void ValueCurve::setLookupTableSize(const uint size)
+{
+    if (size == 0)
+    {
+        normalizeLut.clear();
+        denormalizeLut.clear();
+        return;
+    }
+
+    normalizeLut.resize(size + 1);
+    denormalizeLut.resize(size + 1);
+    update();
+}
+
+ValueCurve::Type ValueCurve::getType() const noexcept
+{
+    return type;
+}
+
+float ValueCurve::getShape() const noexcept
+{
+    return shape;
+}
+
+float ValueCurve::getMinimum() const noexcept
+{
+    return minimum;
+}
+
+float ValueCurve::getMaximum() const noexcept
+{
+    return maximum;
+}
+
+void ValueCurve::update()
+{
+    range = maximum - minimum;
+    invRange = range > 0.0f ? 1.0f / range : 0.0f;
+    offset = 0.0f;
+    scale = invScale = extra = 1.0f;
+
+    // the type may be set before the range, e.g. setUsingLogScale() on a fresh 0-1 slider
+    active = type == kCurveLog && minimum <= 0.0f ? kCurveLinear : type;
+
+    switch (active)
+    {
+    case kCurveLog:
+        offset = std::log(minimum);
+        scale = std::log(maximum / minimum);
+        invScale = 1.0f / scale;
+        break;
+    case kCurveExponential:
+        // a flat curve is linear, and would divide by 0
+        if (std::abs(shape) < 1e-4f)
+            break;
+        scale = std::expm1(shape);
+        invScale = 1.0f / scale;
+        extra = 1.0f / shape;
+        break;
+    case kCurvePower:
+        DISTRHO_SAFE_ASSERT_BREAK(shape > 0.0f);
+        scale = shape;
+        invScale = 1.0f / shape;
+        break;
+    case kCurveDecibel:
+        offset = std::exp(minimum * kDecibelToLog);
+        scale = std::exp(maximum * kDecibelToLog) - offset;
+        invScale = 1.0f / scale;
+        break;
+    default:
+        break;
+    }
+
+    if (denormalizeLut.empty())
+        return;
+
+    const uint size = static_cast<uint>(denormalizeLut.size() - 1);
+
+    for (uint i = 0; i <= size; ++i)
+    {
+        const float position = static_cast<float>(i) / static_cast<float>(size);
+        normalizeLut[i] = computeNormalized(minimum + position * range);
+        denormalizeLut[i] = computeDenormalized(position);
+    }
+}
+
+float ValueCurve::computeNormalized(const float value) const noexcept
+{
+    switch (active)
+    {
+    case kCurveLog:
+        return (std::log(value) - offset) * invScale;
+    case kCurveExponential:
+        if (std::abs(shape) < 1e-4f)
+            break;
+        return std::log1p((value - minimum) * invRange * scale) * extra;
+    case kCurvePower:
+        return std::pow(std::max(0.0f, (value - minimum) * invRange), scale);
+    case kCurveDecibel:
+        return (std::exp(value * kDecibelToLog) - offset) * invScale;
+    case kCurveTable:
+    {
+        const uint last = static_cast<uint>(table.size() - 1);
+        const uint index = static_cast<uint>(std::upper_bound(table.begin(), table.end(), value) - table.begin());
+
+        if (index == 0)
+            return 0.0f;
+        if (index > last)
+            return 1.0f;
+
+        const float lower = table[index - 1];
+        const float upper = table[index];
+        const float frac = upper > lower ? (value - lower) / (upper - lower) : 0.0f;
+
+        return (static_cast<float>(index - 1) + frac) / static_cast<float>(last);
+    }
+    default:
+        break;
+    }
+
+    return (value - minimum) * invRange;
+}
+
+float ValueCurve::computeDenormalized(const float normalized) const noexcept
+{
+    switch (active)
+    {
+    case kCurveLog:
+        return std::exp(offset + normalized * scale);
+    case kCurveExponential:
+        if (std::abs(shape) < 1e-4f)
+            break;
+        return minimum + range * std::expm1(shape * normalized) * invScale;
+    case kCurvePower:
+        return minimum + range * std::pow(std::max(0.0f, normalized), invScale);
+    case kCurveDecibel:
+        return std::log(offset + normalized * scale) / kDecibelToLog;
+    case kCurveTable:
+        return lookup(table.data(), static_cast<uint>(table.size() - 1), normalized);
+    default:
+        break;
+    }
+
+    return minimum + normalized * range;
+}
+
+float ValueCurve::normalize(const float value) const noexcept
+{
+    if (!normalizeLut.empty())
+        return lookup(normalizeLut.data(), static_cast<uint>(normalizeLut.size() - 1), (value - minimum) * invRange);
+
+    return computeNormalized(value);
+}
+
+float ValueCurve::denormalize(const float normalized) const noexcept
+{
+    if (!denormalizeLut.empty())
+        return lookup(denormalizeLut.data(), static_cast<uint>(denormalizeLut.size() - 1), normalized);
+
+    return computeDenormalized(normalized);
+}
+
+void ValueCurve::normalize(const float *const values, float *const results, const uint count) const noexcept
+{
+    // keep the per-type loops free of branches. the linear loops vectorize as is,
+    // the log and exp ones only with a vector math library (e.g. -ffast-math or -fveclib)
+    if (!normalizeLut.empty())
+    {
+        const float *const lut = normalizeLut.data();
+        const uint size = static_cast<uint>(normalizeLut.size() - 1);
+
+        for (uint i = 0; i < count; ++i)
+            results[i] = lookup(lut, size, (values[i] - minimum) * invRange);
+
+        return;
+    }
+
+    switch (active)
+    {
+    case kCurveLinear:
+        for (uint i = 0; i < count; ++i)
+            results[i] = (values[i] - minimum) * invRange;
+        break;
+    case kCurveLog:
+        for (uint i = 0; i < count; ++i)
+            results[i] = (std::log(values[i]) - offset) * invScale;
+        break;
+    case kCurveDecibel:
+        for (uint i = 0; i < count; ++i)
+            results[i] = (std::exp(values[i] * kDecibelToLog) - offset) * invScale;
+        break;
+    default:
+        for (uint i = 0; i < count; ++i)
+            results[i] = computeNormalized(values[i]);
+        break;
+    }
+}
+
+void ValueCurve::denormalize(const float *const normalized, float *const results, const uint count) const noexcept
+{
+    if (!denormalizeLut.empty())
+    {
+        const float *const lut = denormalizeLut.data();
+        const uint size = static_cast<uint>(denormalizeLut.size() - 1);
+
+        for (uint i = 0; i < count; ++i)
+            results[i] = lookup(lut, size, normalized[i]);
+
+        return;
+    }
+
+    switch (active)
+    {
+    case kCurveLinear:
+        for (uint i = 0; i < count; ++i)
+            results[i] = minimum + normalized[i] * range;
+        break;
+    case kCurveLog:
+        for (uint i = 0; i < count; ++i)
+            results[i] = std::exp(offset + normalized[i] * scale);
+        break;
+    default:
+        for (uint i = 0; i < count; ++i)
+            results[i] = computeDenormalized(normalized[i]);
+        break;
+    }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#include "ValueTextCache.hpp"
+#include "ExtraEventHandlers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+ValueTextCache::ValueTextCache(const int decimals, const char *const unitText)
+    : precision(0),
+      precisionScale(1.0),
+      step(0.0f),
+      textValid(false),
+      textKey(0),
+      boundsValid(false),
+      boundsFont(-1),
+      boundsSize(0.0f),
+      boundsAlign(0),
+      bounds()
+{
+    unit[0] = '\0';
+    text[0] = '\0';
+    setPrecision(decimals);
+    setUnit(unitText);
+}
+
+void ValueTextCache::setPrecision(const int decimals) noexcept
+{
+    precision = std::max(0, std::min(decimals, 9));
+    precisionScale = std::pow(10.0, precision);
+    invalidate();
+}
+
+void ValueTextCache::setUnit(const char *const unitText) noexcept
+{
+    if (unitText != nullptr)
+        std::snprintf(unit, sizeof(unit), "%s", unitText);
+    else
+        unit[0] = '\0';
+
+    invalidate();
+}
+
+void ValueTextCache::setStep(const float newStep) noexcept
+{
+    step = newStep;
+    invalidate();
+}
+
+void ValueTextCache::invalidate() noexcept
+{
+    textValid = false;
+    boundsValid = false;
+}
+
+const char *ValueTextCache::getText(float value) noexcept
+{
+    // shown as the slider would step it
+    value = snapToStep(value, step);
+
+    // the value as it will be displayed, as an integer
+    const long long key = std::llround(value * precisionScale);
+
+    if (textValid && key == textKey)
+        return text;
+
+    // format the key itself, so text and key always agree on rounding, and -0 shows as 0
+    const double displayValue = key != 0 ? static_cast<double>(key) / precisionScale : 0.0;
+
+    std::snprintf(text, sizeof(text), "%.*f%s", precision, displayValue, unit);
+    textKey = key;
+    textValid = true;
+    boundsValid = false;
+
+    return text;
+}
+
+const Rectangle<float> &ValueTextCache::getBounds(NanoVG &nvg, const float value,
+                                                  const NanoVG::FontId font, const float size, const int align)
+{
+    getText(value);
+
+    if (boundsValid && boundsFont == font && d_isEqual(boundsSize, size) && boundsAlign == align)
+        return bounds;
+
+    nvg.fontFaceId(font);
+    nvg.fontSize(size);
+    nvg.textAlign(align);
+    nvg.textBounds(0.0f, 0.0f, text, nullptr, bounds);
+
+    boundsFont = font;
+    boundsSize = size;
+    boundsAlign = align;
+    boundsValid = true;
+
+    return bounds;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+const Rectangle<float> &LabelBoundsCache::getBounds(NanoVG &nvg, const uint index, const char *const label,
+                                                    const NanoVG::FontId font, const float size, const int align)
+{
+    static const Rectangle<float> kEmptyBounds;
+
+    DISTRHO_SAFE_ASSERT_RETURN(label != nullptr, kEmptyBounds);
+
+    if (index >= entries.size())
+    {
+        Entry empty;
+        empty.font = -1;
+        empty.size = 0.0f;
+        empty.align = 0;
+        entries.resize(index + 1, empty);
+    }
+
+    Entry &entry(entries[index]);
+
+    // compared by contents, the caller may reuse a buffer for new text
+    if (entry.label == label && entry.font == font && d_isEqual(entry.size, size) && entry.align == align)
+        return entry.bounds;
+
+    nvg.fontFaceId(font);
+    nvg.fontSize(size);
+    nvg.textAlign(align);
+    nvg.textBounds(0.0f, 0.0f, label, nullptr, entry.bounds);
+
+    entry.label = label;
+    entry.font = font;
+    entry.size = size;
+    entry.align = align;
+
+    return entry.bounds;
+}
+
+void LabelBoundsCache::invalidate() noexcept
+{
+    entries.clear();
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL
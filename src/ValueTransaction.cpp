@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2022 Rob van den Berg <rghvdberg at gmail dot com>
+ * SPDX-License-Identifier: ISC
+*/
+
+#include "ValueTransaction.hpp"
+
+#include <algorithm>
+
+START_NAMESPACE_DGL
+
+// --------------------------------------------------------------------------------------------------------------------
+
+ValueTransaction *ValueTransaction::current = nullptr;
+
+ValueTransaction::Participant::Participant() noexcept
+    : transaction(nullptr),
+      transactionCallback(false)
+{
+}
+
+ValueTransaction::Participant::~Participant()
+{
+    // also while the transaction is committing, a callback may destroy a widget still waiting its turn
+    if (transaction != nullptr)
+        transaction->remove(this);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+ValueTransaction::ValueTransaction()
+    : committing(false)
+{
+}
+
+ValueTransaction::~ValueTransaction()
+{
+    if (current == this)
+        commit(true);
+}
+
+void ValueTransaction::begin()
+{
+    DISTRHO_SAFE_ASSERT_RETURN(current == nullptr, );
+
+    current = this;
+}
+
+uint ValueTransaction::commit(const bool sendCallbacks)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(current == this, 0);
+
+    // handlers may set values from their callbacks, those go through normally
+    current = nullptr;
+    committing = true;
+
+    uint count = 0;
+
+    // by index, remove() only clears the slots of participants destroyed meanwhile
+    for (std::size_t i = 0; i < participants.size(); ++i)
+    {
+        Participant *const participant = participants[i];
+
+        if (participant == nullptr)
+            continue;
+
+        const bool sendCallback = sendCallbacks && participant->transactionCallback;
+
+        participant->transaction = nullptr;
+        participant->transactionCallback = false;
+        participant->commitTransaction(sendCallback);
+        ++count;
+    }
+
+    committing = false;
+    participants.clear();
+    return count;
+}
+
+bool ValueTransaction::isActive() const noexcept
+{
+    return current == this;
+}
+
+ValueTransaction *ValueTransaction::getCurrent() noexcept
+{
+    return current;
+}
+
+void ValueTransaction::add(Participant *const participant, const bool sendCallback)
+{
+    participant->transactionCallback |= sendCallback;
+
+    if (participant->transaction == this)
+        return;
+
+    DISTRHO_SAFE_ASSERT_RETURN(participant->transaction == nullptr, );
+
+    participant->transaction = this;
+    participants.push_back(participant);
+}
+
+void ValueTransaction::remove(Participant *const participant) noexcept
+{
+    if (committing)
+        std::replace(participants.begin(), participants.end(), participant, static_cast<Participant *>(nullptr));
+    else
+        participants.erase(std::remove(participants.begin(), participants.end(), participant), participants.end());
+
+    participant->transaction = nullptr;
+    participant->transactionCallback = false;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+END_NAMESPACE_DGL